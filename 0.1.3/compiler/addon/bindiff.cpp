@@ -0,0 +1,214 @@
+// bindiff.cpp : Defines the entry point for the bin diff tool.
+//
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#else
+#error "unsupport platform"
+#endif
+#include <string>
+#include <vector>
+#include <iostream>
+#include <unordered_map>
+#include <chrono>
+#include <algorithm>
+#include "cm_bin.hpp"
+/*!
+ *  \page pg_bindiff bin diff tool
+ *  \section sec_bindiff_use usage
+ * bindiff [-n max] old.bin new.bin
+ *
+ * The records of the two releases are joined by their key, not by their
+ * position, and the added, removed and changed records are reported. The
+ * changed records are reported field by field.
+ *  - C_CR_Toll : (InLinkId, OutLinkId)
+ *  - HW_Junction : junction ID
+ *  - CR : CRID
+ *  - Toll_ETA, Toll_Pattern : CondID
+ *
+ * The records sharing one key are paired by their order in the file.
+ */
+
+//-----------------------------------------------------------------------------
+//  Type Defination
+//-----------------------------------------------------------------------------
+struct bin_key
+{
+   uint64_t k1;
+   uint64_t k2;
+
+   bool operator==(const bin_key& o) const { return k1 == o.k1 && k2 == o.k2; }
+};
+
+struct bin_key_hash
+{
+   size_t operator()(const bin_key& k) const
+   {
+      uint64_t h = k.k1 * 0x9E3779B97F4A7C15ULL;
+      h ^= (k.k2 + 0x632BE59BD9B4E019ULL) * 0xC2B2AE3D27D4EB4FULL;
+      return static_cast<size_t>(h ^ (h >> 29));
+   }
+};
+
+//-----------------------------------------------------------------------------
+//  Local Utility
+//-----------------------------------------------------------------------------
+static const uint32_t NONE = static_cast<uint32_t>(-1);
+
+static bin_key _key(const CCmBin& bin, const CCmBin::record& rec)
+{
+   const char* p = bin.data() + rec.offset;
+   bin_key k = {CCmBin::bits(p, 0, 40), 0};
+   if ( CCmBin::BIN_C_CR_TOLL == bin.get_type() )
+   {
+      k.k2 = CCmBin::bits(p, 40, 40);
+   }
+   return k;
+}
+
+static std::string _key_str(CCmBin::type t, const bin_key& k)
+{
+   std::string s;
+   switch(t)
+   {
+      case CCmBin::BIN_C_CR_TOLL:
+         s = "(InLinkId, OutLinkId) (" + std::to_string(k.k1) + ", " + std::to_string(k.k2) + ")";
+         break;
+      case CCmBin::BIN_HW_JUNCTION:
+         s = "ID " + std::to_string(k.k1);
+         break;
+      case CCmBin::BIN_CR:
+         s = "CRID " + std::to_string(k.k1);
+         break;
+      default:
+         s = "CondID " + std::to_string(k.k1);
+         break;
+   }
+   return s;
+}
+
+static void _usage(const char* exe)
+{
+   std::cout << "usage : " << exe << " [-n max] old.bin new.bin" << std::endl;
+   std::cout << "\t-n max : the maximum lines of the reported differences, 100 by default." << std::endl;
+}
+
+//-----------------------------------------------------------------------------
+//  Main
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+   int opt;
+   size_t max_report = 100;
+   while ((opt = getopt(argc, argv, "n:h")) != -1)
+   {
+      switch (opt)
+      {
+         case 'n':
+            max_report = strtoul(optarg, nullptr, 10);
+            break;
+         default: /* '?' */
+            _usage(argv[0]);
+            exit(EXIT_FAILURE);
+      }
+   }
+
+   if ( 2 != argc - optind )
+   {
+      _usage(argv[0]);
+      exit(EXIT_FAILURE);
+   }
+
+   auto start = std::chrono::steady_clock::now();
+   const char* path_old = argv[optind];
+   const char* path_new = argv[optind + 1];
+   auto t = CCmBin::guess(path_old);
+   CCmBin bin_old, bin_new;
+   if ( ! bin_old.map(path_old, t) || ! bin_new.map(path_new, t) )
+   {
+      std::cout << "failed to read \"" << path_old << "\" or \"" << path_new << "\"." << std::endl;
+      exit(EXIT_FAILURE);
+   }
+
+   // build : the records of the old release chained by key, in file order
+   const auto& rec_old = bin_old.records();
+   const auto& rec_new = bin_new.records();
+   std::unordered_map<bin_key, uint32_t, bin_key_hash> head;
+   std::vector<uint32_t> next(rec_old.size(), NONE);
+   head.reserve(rec_old.size());
+   for (size_t i = rec_old.size(); i-- > 0; )
+   {
+      auto ret = head.insert(std::make_pair(_key(bin_old, rec_old[i]), static_cast<uint32_t>(i)));
+      if ( ! ret.second )
+      {
+         next[i] = ret.first->second;
+         ret.first->second = static_cast<uint32_t>(i);
+      }
+   }
+
+   // probe : pair the records of the new release
+   size_t num_added = 0, num_removed = 0, num_changed = 0, num_same = 0, num_report = 0;
+   std::vector<bool> matched(rec_old.size(), false);
+   std::vector<CCmBin::field> fa, fb;
+   for (const auto& b : rec_new)
+   {
+      auto k = _key(bin_new, b);
+      auto it = head.find(k);
+      if ( head.end() == it || NONE == it->second )
+      {
+         if ( num_report++ < max_report )
+         {
+            std::cout << "added   " << _key_str(t, k) << std::endl;
+         }
+         num_added++;
+         continue;
+      }
+
+      auto i = it->second;
+      it->second = next[i];
+      matched[i] = true;
+
+      const auto& a = rec_old[i];
+      const char* pa = bin_old.data() + a.offset;
+      const char* pb = bin_new.data() + b.offset;
+      if ( a.size == b.size && std::equal(pa, pa + a.size, pb) )
+      {
+         num_same++;
+         continue;
+      }
+
+      num_changed++;
+      if ( num_report < max_report )
+      {
+         bin_old.decode(a, fa);
+         bin_new.decode(b, fb);
+         auto n = CCmBin::compare("changed " + _key_str(t, k), fa, fb, max_report - num_report);
+         num_report += (n > 0) ? n : 1;
+         if ( 0 == n )
+         {
+            std::cout << "changed " << _key_str(t, k) << ", undecoded bytes" << std::endl;
+         }
+      }
+   }
+
+   for (size_t i = 0; i < rec_old.size(); ++i)
+   {
+      if ( ! matched[i] )
+      {
+         if ( num_report++ < max_report )
+         {
+            std::cout << "removed " << _key_str(t, _key(bin_old, rec_old[i])) << std::endl;
+         }
+         num_removed++;
+      }
+   }
+
+   auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+   std::cout << CCmBin::type_name(t) << " : old " << rec_old.size() << " records, new " << rec_new.size() << " records." << std::endl;
+   std::cout << "added " << num_added << ", removed " << num_removed << ", changed " << num_changed
+      << ", same " << num_same << ", in " << ms << " ms." << std::endl;
+
+   return (num_added || num_removed || num_changed) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
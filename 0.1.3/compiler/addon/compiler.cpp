@@ -5,6 +5,7 @@
 #include "stdafx.h"
 #elif defined(__linux__)
 #include <unistd.h>
+#include <getopt.h>
 #include <cstdio>
 #include <cstdlib>
 #else
@@ -21,7 +22,20 @@
  * The working platform is Linux
  *  \section sec_cmd command line option
  * \-m import mid file\n
- * \-d parse db file
+ * \-d parse db file\n
+ * \-p report the sqlite statement profile at exit\n
+ * \-t import the ID fields of mid files as INTEGER (typed schema)\n
+ * \-k keep the db files when C, CR, Toll_ETA and Toll_Pattern mid files are compiled into bin directly\n
+ * \-j threads : split the mid lines, copy the tables to combine, or scan the tables by rowid ranges, on the threads, 1 by default and 0 for all the cores\n
+ * \-c golden.bin output.bin : compare a bin with its golden one field by field\n
+ * \-r write the CRs of C-CR-Toll once into a dictionary, and refer to them by index\n
+ * \-g group the records of C-CR-Toll and HW_Junction by MapID into tiles, after a tile directory\n
+ * \-s expand the VPeriods of C-CR-Toll into a table of weekly 15 minutes slot bitmaps, referred by the CRs\n
+ * \-i index the records of C-CR-Toll by the vehicle classes of their CRs, as compressed bitmaps after the bin\n
+ * \--mem-limit size : keep the buffered records, the sorts and the DB cache within the bytes, such as 512M or 2G, by spilling them to the disk\n
+ * \--big-endian write the bins in big endian, as the 64 bits words of the record layouts\n
+ * \--validate check the CRIDs and CondIDs of C against CR, Toll_ETA and Toll_Pattern before C-CR-Toll is compiled, and report the dangling, duplicated and truncated ones\n
+ * \--overflow carry the CRs over 15 and the lanes over the ETA block of the C-CR-Toll records in the extension blocks after them, flagged in the record header
  */
 #ifdef WIN32
 int _tmain(int argc, _TCHAR* argv[])
@@ -35,8 +49,18 @@ int _tmain(int argc, _TCHAR* argv[])
 int main(int argc, char* argv[])
 {
    int opt, optnum = 0;
+   int retval = EXIT_SUCCESS;
    bool sth_done = false;
-   while ((opt = getopt(argc, argv, "vh")) != -1) 
+   bool compare = false;
+   static const struct option long_opt[] = 
+   {
+      {"mem-limit", required_argument, nullptr, CM_OPT_MEM_LIMIT},
+      {"big-endian", no_argument, nullptr, CM_OPT_BIG_ENDIAN},
+      {"validate", no_argument, nullptr, CM_OPT_VALIDATE},
+      {"overflow", no_argument, nullptr, CM_OPT_OVERFLOW},
+      {nullptr, 0, nullptr, 0}
+   };
+   while ((opt = getopt_long(argc, argv, "vhptkj:crgsi", long_opt, nullptr)) != -1) 
    {
       switch (opt) 
       {
@@ -49,6 +73,66 @@ int main(int argc, char* argv[])
             std::cout << "\t" << AUTHOR << " compiled at " << __TIME__ << " on " << __DATE__ << std::endl;
             sth_done = true;
             break;
+         case 'p':
+            ///< profile the sqlite statements
+            cm_option(opt, optarg);
+            break;
+         case 't':
+            ///< typed schema of the imported DB
+            cm_option(opt, optarg);
+            break;
+         case 'k':
+            ///< keep the db files of the direct compile
+            cm_option(opt, optarg);
+            break;
+         case 'j':
+            ///< threads to read the mid files
+            if ( EXIT_SUCCESS != cm_option(opt, optarg) )
+            {
+               exit(EXIT_FAILURE);
+            }
+            break;
+         case 'r':
+            ///< CR dictionary of C-CR-Toll
+            cm_option(opt, optarg);
+            break;
+         case 'g':
+            ///< tiles of C-CR-Toll and HW_Junction by MapID
+            cm_option(opt, optarg);
+            break;
+         case 's':
+            ///< VPeriod slot table of C-CR-Toll
+            cm_option(opt, optarg);
+            break;
+         case 'i':
+            ///< vehicle class index of C-CR-Toll
+            cm_option(opt, optarg);
+            break;
+         case CM_OPT_MEM_LIMIT:
+            ///< spill to the disk over the memory limit
+            if ( EXIT_SUCCESS != cm_option(opt, optarg) )
+            {
+               exit(EXIT_FAILURE);
+            }
+            break;
+         case CM_OPT_BIG_ENDIAN:
+            ///< byte order of the bins
+            cm_option(opt, optarg);
+            break;
+         case CM_OPT_VALIDATE:
+            ///< referential integrity of C-CR-Toll
+            cm_option(opt, optarg);
+            break;
+         case CM_OPT_OVERFLOW:
+            ///< extension blocks of C-CR-Toll
+            cm_option(opt, optarg);
+            break;
+         case 'c':
+            ///< compare bin files
+            optnum++;
+            compare = true;
+            sth_done = true;
+            break;
          case 'h':
             //nsecs = atoi(optarg);
             optnum++;
@@ -60,9 +144,21 @@ int main(int argc, char* argv[])
       }
    }
 
-   if (0 == optnum) 
+   if ( compare )
+   {
+      if ( 2 == argc - optind )
+      {
+         retval = cm_compare(argv[optind], argv[optind + 1]);
+      }
+      else
+      {
+         std::cout << "usage : " << argv[0] << " -c golden.bin output.bin" << std::endl;
+         retval = EXIT_FAILURE;
+      }
+   }
+   else if (0 == optnum) 
    {
-      cm_argv(argc, argv);
+      cm_argv(argc - optind + 1, argv + optind - 1);
    }
    else
    {
@@ -72,7 +168,7 @@ int main(int argc, char* argv[])
       }
    }
 
-	return 0;
+	return retval;
 }
 #endif
 
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "cm_strview.hpp"
+
+/// \brief bump allocator for the row buffers of one batch
+///
+/// The memory is handed out by moving a pointer in big blocks. Nothing is
+/// freed by piece, reset() rewinds the whole arena at the end of a batch and
+/// keeps the blocks, so the next batch allocates nothing from the heap.
+class CCmArena
+{
+public:
+   CCmArena(size_t = 64 * 1024);
+   CCmArena(const CCmArena&) = delete;
+   CCmArena& operator=(const CCmArena&) = delete;
+   ~CCmArena();
+
+   void* alloc(size_t, size_t = sizeof(void*));
+   char* alloc_text(size_t n) { return static_cast<char*>(alloc(n, 1)); }
+   CCmStrView copy(const CCmStrView&);
+   void reset();
+
+   size_t used() const;
+   size_t block_num() const { return m_blocks.size(); }
+private:
+   struct block
+   {
+      char* addr;
+      size_t size;
+   };
+   std::vector<block> m_blocks;
+   size_t m_blksiz;
+   size_t m_cur;                          ///< the block in use
+   size_t m_pos;                          ///< the offset in the block in use
+};
+
+unsigned long long cm_alloc_count();
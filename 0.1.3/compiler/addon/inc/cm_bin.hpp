@@ -0,0 +1,102 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/// \brief reader of the compiled bin files
+///
+/// The records are decoded by the documented byte layouts, not by the
+/// structures of the compiler, so the output of the compiler can be checked
+/// against it.
+class CCmBin
+{
+public:
+   enum type
+   {
+      BIN_UNKNOWN,
+      BIN_CR,
+      BIN_TOLL_ETA,
+      BIN_TOLL_PATTERN,
+      BIN_HW_JUNCTION,
+      BIN_C_CR_TOLL,
+      BIN_N,
+   };
+
+   struct field
+   {
+      std::string name;
+      uint64_t value;
+   };
+
+   struct record
+   {
+      size_t offset;                      ///< byte offset in the file
+      size_t size;                        ///< byte size of the record
+   };
+
+   /// \brief the records of a mesh in the tiled bin
+   struct tile
+   {
+      uint32_t mapid;
+      size_t recnum;
+      size_t offset;                      ///< byte offset of the first record
+      size_t size;                        ///< byte size of the records
+   };
+
+   CCmBin();
+   CCmBin(const CCmBin&) = delete;
+   CCmBin& operator=(const CCmBin&) = delete;
+   ~CCmBin();
+
+   static type guess(const char*);
+   static const char* type_name(type);
+   static uint64_t bits(const char*, size_t, size_t);
+   static size_t compare(const std::string&, const std::vector<field>&, const std::vector<field>&, size_t);
+   bool load(const char*, type = BIN_UNKNOWN);
+   bool map(const char*, type = BIN_UNKNOWN);
+
+   type get_type() const { return m_type; }
+   const char* data() const { return m_data; }
+   size_t size() const { return m_size; }
+   const std::vector<record>& records() const { return m_rec; }
+   const std::vector<tile>& tiles() const { return m_tile; }
+   /// \brief the records refer to the data out of them, such as the neighbors of N or the CR dictionary
+   bool refers_out() const { return BIN_N == m_type || nullptr != m_dict || nullptr != m_slots || nullptr != m_veh; }
+   size_t header_size() const;
+   void decode_header(std::vector<field>&) const;
+   void decode(const record&, std::vector<field>&) const;
+   /// \brief the vehicle class index of C-CR-Toll, by the ordinals of the records
+   bool has_veh_index() const { return nullptr != m_veh; }
+   size_t veh_count(size_t) const;
+   bool veh_contains(size_t, size_t) const;
+   void veh_records(size_t, std::vector<size_t>&) const;
+private:
+   bool index();
+   bool index_N();
+   bool index_tiles(size_t&, bool);
+   bool index_veh(size_t);
+   void decode_slot(std::vector<field>&, const std::string&, size_t) const;
+   size_t record_size(size_t) const;
+private:
+   type m_type;
+   std::string m_buf;
+   void* m_map;                           ///< the mapped file, if mapped
+   const char* m_data;
+   size_t m_size;
+   std::vector<record> m_rec;
+   std::vector<tile> m_tile;              ///< the tile directory, empty if not tiled
+   const char* m_dict;                    ///< the CR dictionary of C-CR-Toll, if any
+   size_t m_dictnum;
+   const char* m_slots;                   ///< the VPeriod slot table of C-CR-Toll, if any
+   size_t m_slotnum;
+   size_t m_slotsiz;                      ///< the bytes of an entry
+   const char* m_veh;                     ///< the vehicle class index of C-CR-Toll, if any
+   const char* m_attr;                    ///< the sections of N after the node IDs
+   const char* m_nbr_off;
+   const char* m_nbr;
+   const char* m_link_off;
+   const char* m_link;
+};
+
+int cm_bin_compare(const char*, const char*, size_t = 100);
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "cm_strview.hpp"
+
+/// \brief the keys of a table, with the rows of each
+class CCmKeySet
+{
+public:
+   CCmKeySet() : m_rows(0) {}
+
+   /// \brief add a row of the key, over if the row doesn't fit in the bin
+   void add(const CCmStrView& key, bool over = false);
+   /// \brief the rows of the key, 0 if it is not found
+   uint32_t rows(const std::string&) const;
+   /// \brief whether the first row of the key, the one kept in the bin, doesn't fit in it
+   bool over(const std::string&) const;
+
+   size_t size() const { return m_key.size(); }
+   size_t row_num() const { return m_rows; }
+private:
+   struct entry
+   {
+      uint32_t rows;
+      bool over;                          ///< of the first row
+   };
+   friend class CCmValidator;
+
+   std::unordered_map<std::string, entry> m_key;
+   std::string m_buf;                     ///< the key added
+   size_t m_rows;
+};
+
+/// \brief referential integrity of C against CR, Toll_ETA and Toll_Pattern
+///
+/// The keys of CR, Toll_ETA and Toll_Pattern are loaded into the hash sets
+/// on the threads, one table a thread, then the rows of C are probed by the
+/// sets. The dangling references, the duplicated keys and the data the bin
+/// can't hold are counted with some samples, and reported at last.
+class CCmValidator
+{
+public:
+   enum table { CR, TOLL_ETA, TOLL_PATTERN, TABLE_NUM };
+   enum issue
+   {
+      CRID_DANGLING,                      ///< the CRID of C is not in CR
+      CONDID_DANGLING,                    ///< the CondID of C is in neither Toll_ETA nor Toll_Pattern
+      ETA_DUPLICATED,                     ///< the CondID has more than one Toll_ETA row
+      PATTERN_DUPLICATED,                 ///< the CondID has more than one Toll_Pattern row
+      CR_TRUNCATED,                       ///< the CRs of the CRID of C are over the limit
+      LANE_DROPPED,                       ///< the lanes of the Toll_ETA of C don't fit in the ETA block, which is dropped
+      LANE_TRUNCATED,                     ///< the lanes of the Toll_ETA of C don't fit in the extension block either
+      ISSUE_NUM
+   };
+   /// \brief load the keys of a table into the set, false if it fails
+   typedef std::function<bool(CCmKeySet&)> key_load;
+
+   CCmValidator(size_t cr_max, bool lane_ext, size_t threads = 1);
+
+   bool load(const key_load (&)[TABLE_NUM]);
+   void probe(size_t row, const CCmStrView& CRID, const CCmStrView& CondID);
+   void report() const;
+
+   const CCmKeySet& keys(table t) const { return m_keys[t]; }
+   size_t count(issue i) const { return m_issue[i].count; }
+private:
+   struct found
+   {
+      size_t count;
+      std::vector<std::string> sample;
+
+      found() : count(0) {}
+   };
+
+   template<typename F> void add(issue, F);
+   void duplicated(table, issue);
+private:
+   size_t m_cr_max;
+   bool m_lane_ext;                       ///< the lanes over the ETA block are kept in the extension block
+   size_t m_threads;
+   CCmKeySet m_keys[TABLE_NUM];
+   found m_issue[ISSUE_NUM];
+   size_t m_probed;
+   std::string m_key;                     ///< the key probed
+};
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/// \brief the error of the conversion, as std::errc of std::from_chars
+enum class CCmConvErr
+{
+   ok = 0,
+   invalid_argument,                   ///< no digit at all
+   result_out_of_range                 ///< the value does not fit in the type
+};
+
+/// \brief the result of the conversion, as std::from_chars_result
+struct CCmConvResult
+{
+   const char* ptr;                    ///< the first char not parsed
+   CCmConvErr ec;
+};
+
+/// \brief parse the unsigned integer at the beginning of [first, last)
+///
+/// It is the same with std::from_chars of C++17 : no space, sign or "0x"
+/// prefix is accepted, the value is not changed on error, and ptr is after
+/// all the digits even if the value is out of range. The base is 2 to 36,
+/// the base 2, 10 and 16 are parsed 8 chars at once.
+CCmConvResult cm_from_chars(const char* first, const char* last, uint64_t& value, int base = 10);
+CCmConvResult cm_from_chars(const char* first, const char* last, uint32_t& value, int base = 10);
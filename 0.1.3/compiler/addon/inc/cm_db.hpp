@@ -1,54 +1,77 @@
-#pragma once
-#include <locale>
-#include <string>
-#include <cstdint>
-#include "cm_sqlite.hpp"
-/*!
- *  \defgroup grp_db db group
- * 
- *  \brief    something about CM db
- *  
- *  some detail about CM db
- */
-/// \brief compiler Database
-class CCmDatabase
-{
-public:
-   CCmDatabase();
-   ~CCmDatabase();
-
-   bool import_mid(const char*);
-   bool parse_db(const char*);
-   bool do_argv(std::vector<std::string>&);
-private:
-   // helper
-   bool open_mid(const char*, const size_t, const char*);
-   bool open_mid_N(const char*);
-   bool open_mid_C(const char*);
-   bool open_mid_CR(const char*);
-   bool open_mid_Toll_ETA(const char*);
-   bool open_mid_Toll_Pattern(const char*);
-   bool open_mid_HW_Junction(const char*);
-   bool open_db(const char*);
-   bool save_as(const char*);
-   bool parse_db_CR(const char*);
-   bool parse_db_Toll_ETA(const char*);
-   bool parse_db_Toll_Pattern(const char*);
-   bool parse_db_HW_Junction(const char*);
-   bool parse_db_C_CR_Toll(const char*);
-   std::string parse_db_C_CR_Toll();
-   
-   bool combine_db_C_CR(const char*, const char*, const char*);
-   bool combine_db_C_CR_Toll(const char*, const char*, const char*, const char*, const char*);
-   // utilities
-   bool isLeadSameIcStr(const std::string&, const std::string&, std::string::size_type = std::string::npos);
-   void fit_to_graph(std::string&);
-   std::tuple<std::string, std::string, std::string> parse_path(const std::string&);
-private:
-   CCmSqlite* m_db;
-   std::locale m_loc;
-   CCmSqlite::statement *m_stmtSelectCR;
-   CCmSqlite::statement *m_stmtSelectTollETA;
-   CCmSqlite::statement *m_stmtSelectTollPatern;
-   CCmSqlite::statement *m_stmtSelectHWJunction;
-};
+#pragma once
+#include <locale>
+#include <functional>
+#include <string>
+#include <cstdint>
+#include "cm_sqlite.hpp"
+/*!
+ *  \defgroup grp_db db group
+ * 
+ *  \brief    something about CM db
+ *  
+ *  some detail about CM db
+ */
+/// \brief compiler options, set by the command line
+struct CCmOption
+{
+   bool profile;                          ///< report the statement statistics of sqlite
+   bool typed;                            ///< import the ID fields as INTEGER
+   bool keep_db;                          ///< keep the db files of the direct compile
+   size_t threads;                        ///< threads to split the mid lines
+   bool cr_dict;                          ///< refer to the CRs of C-CR-Toll by the dictionary
+   bool tiled;                            ///< group the C-CR-Toll and HW Junction records by MapID
+   bool vp_slots;                         ///< refer to the weekly time slots of the VPeriods from the CRs of C-CR-Toll
+   bool veh_index;                        ///< index the records of C-CR-Toll by the vehicle classes
+   size_t mem_limit;                      ///< the bytes of the buffers, sorts and DB cache, 0 for no limit
+   bool big_endian;                       ///< write the bins in big endian
+   bool validate;                         ///< check the references of C-CR-Toll before it is compiled
+   bool overflow;                         ///< carry the CRs and the lanes over the limits of the C-CR-Toll records in their extension blocks
+
+   CCmOption() : profile(false), typed(false), keep_db(false), threads(1), cr_dict(false), tiled(false), vp_slots(false), veh_index(false), mem_limit(0), big_endian(false), validate(false), overflow(false) {}
+};
+
+struct CCmRangeOut;
+class CCmBinWriter;
+
+/// \brief compiler Database
+class CCmDatabase
+{
+public:
+   CCmDatabase(const CCmOption& = CCmOption());
+   ~CCmDatabase();
+
+   bool import_mid(const char*);
+   bool parse_db(const char*);
+   bool do_argv(std::vector<std::string>&);
+private:
+   // helper
+   template<typename S> bool open_mid(const char*);   ///< S is the schema of the table
+   bool open_db(const char*, bool = false);
+   bool open_work_db(const char*);
+   bool save_as(const char*);
+   typedef std::function<void(CCmSqlite&, CCmSqlite::statement*, CCmRangeOut&)> range_scan;
+   typedef std::function<void(CCmRangeOut&)> range_put;
+   bool scan_table(const char*, const char*, CCmBinWriter&, const range_scan&, const range_put& = range_put(), bool = false);
+   bool parse_db_N(const char*);
+   bool parse_db_CR(const char*);
+   bool parse_db_Toll_ETA(const char*);
+   bool parse_db_Toll_Pattern(const char*);
+   bool parse_db_HW_Junction(const char*);
+   bool parse_db_C_CR_Toll(const char*);
+   bool parse_db_C_CR_Toll(CCmBinWriter&);
+   
+   bool combine_db_C_CR(const char*, const char*, const char*);
+   bool combine_db_C_CR_Toll(const char*, const char*, const char*, const char*, const char*);
+   bool compile_mid_C_CR_Toll(const char*, const char*, const char*, const char*, const char*);
+   bool validate_db_C_CR_Toll();
+   // utilities
+   bool isLeadSameIcStr(const std::string&, const std::string&, std::string::size_type = std::string::npos);
+   void fit_to_graph(std::string&);
+   std::tuple<std::string, std::string, std::string> parse_path(const std::string&);
+private:
+   CCmSqlite* m_db;
+   std::string m_db_path;                 ///< of m_db, for the connections of the threads
+   std::string m_work;                    ///< the work DB file under the memory limit, until saved
+   CCmOption m_opt;
+   std::locale m_loc;
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include "cm_arena.hpp"
+#include "cm_strview.hpp"
+
+/// \brief FNV-1a hash of the text
+struct CCmStrViewHash
+{
+   size_t operator()(const CCmStrView& s) const
+   {
+      uint64_t h = 14695981039346656037ULL;
+      for (size_t i = 0; i < s.len; ++i)
+      {
+         h = (h ^ static_cast<unsigned char>(s.ptr[i])) * 1099511628211ULL;
+      }
+      return static_cast<size_t>(h);
+   }
+};
+
+/// \brief memo of the values converted from the repeated texts
+///
+/// The texts are copied into the own arena as the keys, so the views given
+/// are not kept and a hit allocates nothing. The memo stops growing at the
+/// limit, the new texts after it are converted every time.
+template<typename V>
+class CCmMemo
+{
+public:
+   explicit CCmMemo(size_t limit = 4096) : m_limit(limit), m_hit(0), m_miss(0) {}
+   CCmMemo(const CCmMemo&) = delete;
+   CCmMemo& operator=(const CCmMemo&) = delete;
+
+   /// \brief the value of the text, conv(text) is called on a miss
+   ///
+   /// The value is valid until the next call.
+   template<typename F>
+   const V& get(const CCmStrView& text, F conv)
+   {
+      auto it = m_map.find(text);
+      if ( m_map.end() != it )
+      {
+         m_hit++;
+         return it->second;
+      }
+
+      m_miss++;
+      if ( m_map.size() < m_limit )
+      {
+         return m_map.emplace(m_text.copy(text), conv(text)).first->second;
+      }
+      m_over = conv(text);
+      return m_over;
+   }
+
+   size_t hit() const { return m_hit; }
+   size_t miss() const { return m_miss; }
+   size_t size() const { return m_map.size(); }
+private:
+   CCmArena m_text;
+   std::unordered_map<CCmStrView, V, CCmStrViewHash> m_map;
+   V m_over;                           ///< the value of the text out of the limit
+   size_t m_limit;
+   size_t m_hit;
+   size_t m_miss;
+};
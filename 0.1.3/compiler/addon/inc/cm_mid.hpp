@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "cm_strview.hpp"
+
+/// \brief reader of the mid files
+///
+/// The file is read by big blocks of whole lines. A block is divided into
+/// chunks at the line ends, and the chunks are split into fields on the
+/// threads while the lines of the previous block are handed out in the file
+/// order. The fields are the same with the line by line reader :
+///  - the line is split at every comma, the last empty field is dropped;
+///  - the text between the first and the last quotes of a field is kept;
+///  - the fields after the last one of a short line keep the values of the
+///    previous line.
+class CCmMidReader
+{
+public:
+   CCmMidReader(const char*, size_t, size_t = 1, size_t = 16 * 1024 * 1024);
+   CCmMidReader(const CCmMidReader&) = delete;
+   CCmMidReader& operator=(const CCmMidReader&) = delete;
+   ~CCmMidReader();
+
+   bool is_open() const { return m_file.is_open(); }
+   const CCmStrView* next();
+   size_t count() const { return m_count; }
+   size_t line_num() const { return m_lineno; }
+private:
+   /// the fields of the lines in a part of the block
+   struct chunk
+   {
+      const char* begin;
+      const char* end;
+      std::vector<CCmStrView> field;   ///< fldnum fields per line
+      std::vector<unsigned char> count;///< the fields in the line, 0 lines are skipped
+   };
+
+   struct block
+   {
+      std::string buf;
+      std::vector<chunk> chunks;
+      bool last;                       ///< the last block of the file
+   };
+
+   void load(block&);
+   void split(chunk&) const;
+   void start();
+   void finish();
+   void carry();
+private:
+   std::ifstream m_file;
+   size_t m_fldnum;
+   size_t m_threads;
+   size_t m_blksiz;
+   std::string m_tail;                 ///< the partial line at the end of the last read
+   block m_blk[2];
+   size_t m_cur;                       ///< the block handed out
+   std::thread m_loader;               ///< loads the other block
+   size_t m_chunk;                     ///< the chunk handed out
+   size_t m_line;                      ///< the line handed out in the chunk
+   size_t m_count;
+   size_t m_lineno;
+   std::vector<CCmStrView> m_last;     ///< the fields of the previous line
+   std::vector<std::string> m_carry;   ///< the copies of m_last out of the released block
+};
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+static const bool CM_HOST_BIG_ENDIAN = true;
+#else
+static const bool CM_HOST_BIG_ENDIAN = false;
+#endif
+
+#if defined(_MSC_VER)
+#define CM_BSWAP16(v)   _byteswap_ushort(v)
+#define CM_BSWAP32(v)   _byteswap_ulong(v)
+#define CM_BSWAP64(v)   _byteswap_uint64(v)
+#else
+#define CM_BSWAP16(v)   __builtin_bswap16(v)
+#define CM_BSWAP32(v)   __builtin_bswap32(v)
+#define CM_BSWAP64(v)   __builtin_bswap64(v)
+#endif
+
+/// \brief reverse the bytes of the unsigned integer, chosen by its size at compile time
+template<typename T>
+inline T cm_bswap(T v)
+{
+   static_assert(std::is_unsigned<T>::value, "cm_bswap");
+   return 8 == sizeof(T) ? static_cast<T>(CM_BSWAP64(static_cast<uint64_t>(v)))
+        : 4 == sizeof(T) ? static_cast<T>(CM_BSWAP32(static_cast<uint32_t>(v)))
+        : 2 == sizeof(T) ? static_cast<T>(CM_BSWAP16(static_cast<uint16_t>(v)))
+        : v;
+}
+
+/// \brief the unsigned integer in the byte order, big endian if big
+template<typename T>
+inline T cm_order(T v, bool big)
+{
+   return big != CM_HOST_BIG_ENDIAN ? cm_bswap(v) : v;
+}
+
+/// \brief the bits [SHIFT, SHIFT + BITS) of the word WORD of a record
+template<unsigned WORD, unsigned SHIFT, unsigned BITS>
+struct CCmField
+{
+   static_assert(BITS > 0 && SHIFT + BITS <= 64, "the field is out of the word");
+
+   static const unsigned word = WORD;
+   static uint64_t mask() { return BITS < 64 ? (uint64_t(1) << (BITS % 64)) - 1 : ~uint64_t(0); }
+   static uint64_t put(uint64_t v) { return (v & mask()) << SHIFT; }
+   static uint64_t get(uint64_t w) { return (w >> SHIFT) & mask(); }
+};
+
+/// \brief a record of the bins as N 64 bits words
+///
+/// The fields are put into and got from the words by shifts, as the layout
+/// given by CCmField, instead of the bit fields whose packing is up to the
+/// compiler. The words are stored in the byte order of the bin, so the same
+/// layout is read on the big endian targets by the same shifts.
+template<size_t N>
+struct CCmWords
+{
+   uint64_t w[N];
+
+   template<typename F> void put(uint64_t v)
+   {
+      static_assert(F::word < N, "the field is out of the record");
+      w[F::word] |= F::put(v);
+   }
+   template<typename F> uint64_t get() const
+   {
+      static_assert(F::word < N, "the field is out of the record");
+      return F::get(w[F::word]);
+   }
+
+   void store(void* dst, bool big) const
+   {
+      for (size_t i = 0; i < N; ++i)
+      {
+         uint64_t v = cm_order(w[i], big);
+         std::memcpy(static_cast<char*>(dst) + sizeof(v) * i, &v, sizeof(v));
+      }
+   }
+   void load(const void* src, bool big)
+   {
+      for (size_t i = 0; i < N; ++i)
+      {
+         std::memcpy(&w[i], static_cast<const char*>(src) + sizeof(w[i]) * i, sizeof(w[i]));
+         w[i] = cm_order(w[i], big);
+      }
+   }
+};
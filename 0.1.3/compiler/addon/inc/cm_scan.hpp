@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/// \brief the structural characters of 64 bytes of mid text, a bit a byte
+struct CCmScanMask
+{
+   uint64_t comma;
+   uint64_t quote;
+   uint64_t eol;
+};
+
+/// \brief scan 64 bytes into the masks
+typedef void (*cm_scan_fn)(const char*, CCmScanMask&);
+
+cm_scan_fn cm_scan_kernel();
+const char* cm_scan_isa();
+void cm_scan(const char*, size_t, CCmScanMask&);
+
+/// \brief index of the lowest set bit, the bits must not be 0
+inline size_t cm_ctz64(uint64_t bits)
+{
+#if defined(_M_X64) || defined(_M_ARM64)
+   unsigned long i;
+   _BitScanForward64(&i, bits);
+   return i;
+#elif defined(_MSC_VER)
+   // no 64 bits intrinsic on Win32, by the 32 bits halves
+   unsigned long i;
+   if ( _BitScanForward(&i, static_cast<unsigned long>(bits)) ) {
+      return i;
+   }
+   _BitScanForward(&i, static_cast<unsigned long>(bits >> 32));
+   return 32 + i;
+#else
+   return __builtin_ctzll(bits);
+#endif
+}
+
+/// \brief number of the zero bits above the highest set bit, the bits must not be 0
+inline size_t cm_clz64(uint64_t bits)
+{
+#if defined(_M_X64) || defined(_M_ARM64)
+   unsigned long i;
+   _BitScanReverse64(&i, bits);
+   return 63 - i;
+#elif defined(_MSC_VER)
+   unsigned long i;
+   if ( _BitScanReverse(&i, static_cast<unsigned long>(bits >> 32)) ) {
+      return 31 - i;
+   }
+   _BitScanReverse(&i, static_cast<unsigned long>(bits));
+   return 63 - i;
+#else
+   return __builtin_clzll(bits);
+#endif
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/// \brief external merge sort of the records by a key
+///
+/// The records are kept in memory up to the limit, then sorted by the key
+/// and written as a run into a spill file, which is removed as it is closed.
+/// merge() gives the records of all the runs in the order of the key, and
+/// the records of the same key in the order they are added. Without the
+/// limit nothing is spilled, and the records are only sorted in memory.
+class CCmSpill
+{
+public:
+   typedef std::function<void(uint32_t, const char*, size_t)> record_put;
+
+   explicit CCmSpill(size_t limit = 0, const std::string& dir = std::string());
+   CCmSpill(const CCmSpill&) = delete;
+   CCmSpill& operator=(const CCmSpill&) = delete;
+   ~CCmSpill();
+
+   bool good() const { return m_ok; }
+   void add(uint32_t, const void*, size_t);
+   bool merge(const record_put&);
+
+   size_t size() const { return m_count; }
+   size_t runs() const { return m_run.size(); }
+   /// \brief the number of the records by the key
+   const std::map<uint32_t, size_t>& keys() const { return m_keys; }
+private:
+   struct item
+   {
+      uint32_t key;
+      uint32_t size;
+      size_t pos;                         ///< in m_buf
+   };
+
+   void sort();
+   bool spill();
+   FILE* open_run();
+private:
+   size_t m_limit;
+   std::string m_dir;                     ///< of the spill files
+   bool m_ok;
+   std::string m_buf;                     ///< the records not spilled
+   std::vector<item> m_item;
+   std::vector<FILE*> m_run;              ///< the spilled runs, in the order they are added
+   std::vector<std::vector<char>> m_vbuf; ///< the stdio buffers of the runs
+   std::map<uint32_t, size_t> m_keys;
+   size_t m_count;
+   uint64_t m_spilled;                    ///< the bytes of the runs
+};
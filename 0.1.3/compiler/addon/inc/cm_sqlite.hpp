@@ -1,41 +1,119 @@
-#pragma once
-#include <vector>
-#include <string>
-#include "sqlite3.h"
-
-class CCmSqlite
-{
-public:
-   CCmSqlite(const char*);
-   ~CCmSqlite();
-
-   class statement
-   {
-   public:
-      // life cycle
-      statement() = delete;
-      statement(sqlite3*, const char*);
-      ~statement();
-
-      // helper
-      bool step();
-      bool step_row();
-      const char* get_text(size_t);
-      bool bind_text(size_t, const char*);
-      void reset();
-   private:
-      std::string m_sql;
-      sqlite3_stmt* m_stmt;
-   };
-
-   statement* create_statement(const char*);
-   void remove_statement(statement*);
-   bool execute(const char*);
-   bool backup(const char*);
-   bool attach(const char*, const char*);
-   bool detach(const char*);
-private:
-   sqlite3* m_db;
-   std::vector<statement*> m_stmt;
-};
-
+#pragma once
+#include <vector>
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include "sqlite3.h"
+#include "cm_strview.hpp"
+
+class CCmSqlite
+{
+public:
+   CCmSqlite(const char*, bool = false);
+   ~CCmSqlite();
+
+   class statement
+   {
+      friend class CCmSqlite;
+   public:
+      // life cycle
+      statement() = delete;
+      statement(sqlite3*, const char*);
+      ~statement();
+
+      // helper
+      bool step();
+      bool step_row();
+      const char* get_text(size_t);
+      CCmStrView get_text_view(size_t);
+      int64_t get_int64(size_t);
+      const void* get_blob(size_t, size_t&);
+      int get_type(size_t);
+      bool bind_text(size_t, const char*);
+      bool bind_text(size_t, const CCmStrView&);
+      bool bind_int64(size_t, int64_t);
+      void reset();
+      const char* error() const;
+   private:
+      std::string m_sql;
+      sqlite3_stmt* m_stmt;
+      uint64_t m_steps;
+   };
+
+   /// \brief statistics of one SQL text, collected when profiling is on
+   struct profile
+   {
+      uint64_t prepares;                  ///< statements prepared by the text
+      uint64_t steps;                     ///< sqlite3_step calls
+      uint64_t fullscan;                  ///< SQLITE_STMTSTATUS_FULLSCAN_STEP
+      uint64_t sorts;                     ///< SQLITE_STMTSTATUS_SORT
+      uint64_t autoindex;                 ///< SQLITE_STMTSTATUS_AUTOINDEX
+      uint64_t vm_steps;                  ///< SQLITE_STMTSTATUS_VM_STEP
+      uint64_t nanosec;                   ///< cumulative run time by trace
+      int params;                         ///< bound parameter number
+   };
+
+   statement* create_statement(const char*);
+   statement* cached_statement(const char*);
+   void remove_statement(statement*);
+   bool execute(const char*);
+   bool backup(const char*);
+   bool attach(const char*, const char*);
+   bool detach(const char*);
+   bool copy_table(const char*, const char*);
+   void set_profile(bool);
+   void report_profile();
+private:
+   static int on_trace(unsigned, void*, void*, void*);
+   void collect_profile(statement*);
+private:
+   sqlite3* m_db;
+   std::vector<statement*> m_stmt;
+   std::map<std::string, statement*> m_cache;   ///< by cached_statement(), kept in m_stmt
+   bool m_profile;
+   std::map<std::string, profile> m_prof;
+};
+
+/// \brief connections to one DB file, leased to the threads
+///
+/// sqlite is built in the multi-thread mode, so a connection and its
+/// statements are used by one thread at a time. The statements prepared by
+/// cached_statement() stay with the connection, every thread reuses the ones
+/// of the connection it leases.
+class CCmSqlitePool
+{
+public:
+   /// \brief the leased connection, given back as it is destroyed
+   class lease
+   {
+   public:
+      lease(CCmSqlitePool*, CCmSqlite*);
+      lease(lease&&);
+      lease(const lease&) = delete;
+      ~lease();
+
+      CCmSqlite* operator->() const { return m_db; }
+      CCmSqlite& operator*() const { return *m_db; }
+   private:
+      CCmSqlitePool* m_pool;
+      CCmSqlite* m_db;
+   };
+
+   CCmSqlitePool(const char*, size_t, bool = true);
+   CCmSqlitePool(const CCmSqlitePool&) = delete;
+   CCmSqlitePool& operator=(const CCmSqlitePool&) = delete;
+
+   lease acquire();
+   size_t size() const { return m_conn.size(); }
+private:
+   void release(CCmSqlite*);
+private:
+   std::vector<std::unique_ptr<CCmSqlite>> m_conn;
+   std::vector<CCmSqlite*> m_free;
+   std::mutex m_mtx;
+   std::condition_variable m_cv;
+};
+
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+/// \brief read only view over a piece of text owned by others
+///
+/// The text is not copied, so the view is valid as long as the owner, e.g.
+/// the current row of a sqlite statement or a block of a CCmArena.
+struct CCmStrView
+{
+   static const size_t npos = static_cast<size_t>(-1);
+
+   const char* ptr;
+   size_t len;
+
+   CCmStrView() : ptr(""), len(0) {}
+   CCmStrView(const char* p, size_t n) : ptr(p), len(n) {}
+   CCmStrView(const char* p) : ptr(p ? p : ""), len(p ? std::strlen(p) : 0) {}
+   CCmStrView(const std::string& s) : ptr(s.data()), len(s.size()) {}
+
+   bool empty() const { return 0 == len; }
+   size_t size() const { return len; }
+   const char* data() const { return ptr; }
+   const char* begin() const { return ptr; }
+   const char* end() const { return ptr + len; }
+   char operator[](size_t i) const { return ptr[i]; }
+   std::string str() const { return std::string(ptr, len); }
+
+   CCmStrView substr(size_t pos, size_t n = npos) const
+   {
+      pos = pos < len ? pos : len;
+      n = n < len - pos ? n : len - pos;
+      return CCmStrView(ptr + pos, n);
+   }
+
+   size_t find(char c, size_t pos = 0) const
+   {
+      for (size_t i = pos; i < len; ++i)
+      {
+         if ( c == ptr[i] )
+         {
+            return i;
+         }
+      }
+      return npos;
+   }
+
+   bool starts_with(const char* s) const
+   {
+      size_t n = std::strlen(s);
+      return n <= len && 0 == std::memcmp(ptr, s, n);
+   }
+
+   bool operator==(const CCmStrView& o) const
+   {
+      return len == o.len && 0 == std::memcmp(ptr, o.ptr, len);
+   }
+};
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// \brief writer of the bin files
+///
+/// The small records are gathered into two big aligned buffers. A full
+/// buffer is handed to the writer thread, which pwrites it at its file
+/// offset while the records go on into the other one, so the encoding and the disk I/O
+/// overlap. The file is opened with O_DIRECT if the file system allows it.
+/// The bytes already written can be patched, such as the header written at
+/// last. The byte order given is the one the encoders write the words of the
+/// bin in; the writer itself copies the bytes as they are.
+class CCmBinWriter
+{
+public:
+   CCmBinWriter(const char*, bool = false, size_t = 1024 * 1024);
+   CCmBinWriter(const CCmBinWriter&) = delete;
+   CCmBinWriter& operator=(const CCmBinWriter&) = delete;
+   ~CCmBinWriter();
+
+   bool is_open() const { return m_fd >= 0; }
+   bool good() const { return m_ok; }
+   bool big_endian() const { return m_big; }
+   uint64_t tell() const { return m_off + m_len; }
+   void write(const void*, size_t);
+   void patch(uint64_t, const void*, size_t);
+   bool close();
+private:
+   void submit();
+   void finish();
+   void run();
+   void stop();
+   void buffered();
+private:
+   std::string m_path;
+   int m_fd;
+   bool m_direct;                      ///< opened with O_DIRECT
+   bool m_big;                         ///< the words of the bin are in big endian
+   bool m_ok;
+   size_t m_blksiz;
+   std::vector<char> m_mem;
+   char* m_buf[2];                     ///< aligned in m_mem
+   size_t m_cur;                       ///< the buffer filled
+   size_t m_len;                       ///< the bytes in the buffer filled
+   uint64_t m_off;                     ///< the file offset of the buffer filled
+   std::thread m_flusher;              ///< writes the buffers handed to it, till close
+   std::mutex m_mutex;
+   std::condition_variable m_cond;
+   bool m_pending;                     ///< a buffer is handed to the flusher and not written yet
+   bool m_stop;                        ///< the flusher exits
+   size_t m_flush_buf;                 ///< the buffer handed to the flusher
+   size_t m_flush_len;
+   uint64_t m_flush_off;
+   bool m_flush_ok;                    ///< result of the last flush, read after finish
+   size_t m_writes;                    ///< the write calls to the system
+};
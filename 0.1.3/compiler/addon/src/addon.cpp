@@ -1,35 +1,165 @@
-#include <cstdlib>
-#include "cm_db.hpp"
-#include "cm_debug.h"
-
-int cm_import_mid(const char* path)
-{
-	int retval = EXIT_SUCCESS;
-	CCmDatabase db;
-   db.import_mid(path); 
-
-	return retval;
-}
-
-int cm_parse_db(const char* path)
-{
-	int retval = EXIT_SUCCESS;
-	CCmDatabase db;
-   db.parse_db(path); 
-
-   return retval;
-}
-
-int cm_argv(int argc, char* argv[])
-{
-   int retval = EXIT_SUCCESS;
-   std::vector<std::string> v;
-   for(int i = 1; i < argc; i++)
-   {
-      v.push_back(argv[i]);
-   }
-   CCmDatabase db;
-   db.do_argv(v);
-
-   return retval;
-}
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <algorithm>
+#include "addon.h"
+#include "cm_db.hpp"
+#include "cm_bin.hpp"
+#include "cm_debug.h"
+
+static CCmOption g_opt;
+
+/// \brief parse the bytes with the suffix K, M or G, 0 for the bad ones and the overflowed ones
+static size_t _parse_size(const char* arg)
+{
+   char* end = nullptr;
+   errno = 0;
+   unsigned long long n = arg ? strtoull(arg, &end, 10) : 0;
+   if ( nullptr == end || end == arg || ERANGE == errno )
+   {
+      return 0;
+   }
+
+   size_t shift = 0;
+   switch(*end)
+   {
+      case 'K': case 'k': shift = 10; break;
+      case 'M': case 'm': shift = 20; break;
+      case 'G': case 'g': shift = 30; break;
+      default: break;
+   }
+   if ( shift > 0 )
+   {
+      end++;
+   }
+   // the trailing chars and the bytes over size_t are bad
+   return ( '\0' == *end && n <= (SIZE_MAX >> shift) ) ? static_cast<size_t>(n << shift) : 0;
+}
+
+/// \brief parse the threads, 0 for all the hardware threads, false for the bad ones
+static bool _parse_threads(const char* arg, size_t& threads)
+{
+   char* end = nullptr;
+   unsigned long long n = (arg && isdigit(static_cast<unsigned char>(*arg))) ? strtoull(arg, &end, 10) : 0;
+   bool ok = nullptr != end && '\0' == *end;
+   if ( ok )
+   {
+      const size_t hw = std::max(std::thread::hardware_concurrency(), 1u);
+      if ( n > hw )
+      {
+         CM_LOG_WARNING("threads %s over the %zu hardware threads, %zu are used", arg, hw, hw);
+      }
+      threads = (0 == n || n > hw) ? hw : static_cast<size_t>(n);
+   }
+   return ok;
+}
+
+int cm_option(int opt, const char* arg)
+{
+   int retval = EXIT_SUCCESS;
+   switch(opt)
+   {
+      case 'p':
+         g_opt.profile = true;
+         break;
+
+      case 't':
+         g_opt.typed = true;
+         break;
+
+      case 'k':
+         g_opt.keep_db = true;
+         break;
+
+      case 'r':
+         g_opt.cr_dict = true;
+         break;
+
+      case 'g':
+         g_opt.tiled = true;
+         break;
+
+      case 's':
+         g_opt.vp_slots = true;
+         break;
+
+      case 'i':
+         g_opt.veh_index = true;
+         break;
+
+      case CM_OPT_MEM_LIMIT:
+         g_opt.mem_limit = _parse_size(arg);
+         if ( 0 == g_opt.mem_limit )
+         {
+            CM_LOG_WARNING("bad memory limit \"%s\"", arg ? arg : "");
+            retval = EXIT_FAILURE;
+         }
+         break;
+
+      case CM_OPT_BIG_ENDIAN:
+         g_opt.big_endian = true;
+         break;
+
+      case CM_OPT_VALIDATE:
+         g_opt.validate = true;
+         break;
+
+      case CM_OPT_OVERFLOW:
+         g_opt.overflow = true;
+         break;
+
+      case 'j':
+         if ( ! _parse_threads(arg, g_opt.threads) )
+         {
+            CM_LOG_WARNING("bad threads \"%s\"", arg ? arg : "");
+            retval = EXIT_FAILURE;
+         }
+         break;
+
+      default:
+         CM_LOG_WARNING("unexpected option %c", opt);
+         retval = EXIT_FAILURE;
+         break;
+   }
+
+   return retval;
+}
+
+int cm_import_mid(const char* path)
+{
+	int retval = EXIT_SUCCESS;
+	CCmDatabase db(g_opt);
+   db.import_mid(path); 
+
+	return retval;
+}
+
+int cm_parse_db(const char* path)
+{
+	int retval = EXIT_SUCCESS;
+	CCmDatabase db(g_opt);
+   db.parse_db(path); 
+
+   return retval;
+}
+
+int cm_argv(int argc, char* argv[])
+{
+   int retval = EXIT_SUCCESS;
+   std::vector<std::string> v;
+   for(int i = 1; i < argc; i++)
+   {
+      v.push_back(argv[i]);
+   }
+   CCmDatabase db(g_opt);
+   db.do_argv(v);
+
+   return retval;
+}
+
+int cm_compare(const char* golden, const char* path)
+{
+   return cm_bin_compare(golden, path);
+}
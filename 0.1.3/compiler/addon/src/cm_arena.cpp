@@ -0,0 +1,151 @@
+/*!
+ *    \file  cm_arena.cpp
+ *   \brief  bump arena implement
+ *
+ *  the arena for the row buffers, and the heap allocation counter to check
+ *  that the row loops do not allocate.
+ *
+ *  \author  Wang Xiaolong (WXL), wangxl3@mapbar.com
+ *
+ *  \internal
+ *       Created:  10/19/2026
+ *      Revision:  none
+ *      Compiler:  gcc
+ *  Organization:  mapbar co.
+ *     Copyright:  mapbar
+ *
+ *  This source code is released for free distribution under the terms of the
+ *  GNU General Public License as published by the Free Software Foundation.
+ */
+
+//-----------------------------------------------------------------------------
+//  Header Section
+//-----------------------------------------------------------------------------
+#include <cstdlib>
+#include <new>
+#include <atomic>
+#include <algorithm>
+#include "cm_arena.hpp"
+
+//-----------------------------------------------------------------------------
+//  Heap Allocation Counter Section
+//-----------------------------------------------------------------------------
+#ifdef CM_ALLOC_COUNT
+static std::atomic<unsigned long long> g_alloc_count(0);
+
+void* operator new(size_t n)
+{
+   g_alloc_count++;
+   void* p = std::malloc(n ? n : 1);
+   if ( ! p )
+   {
+      throw std::bad_alloc();
+   }
+   return p;
+}
+
+void* operator new[](size_t n)
+{
+   return operator new(n);
+}
+
+void operator delete(void* p) noexcept
+{
+   std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+   std::free(p);
+}
+#endif
+
+/*!
+ *  \brief  the number of operator new called so far
+ *
+ *  It is counted only when built with CM_ALLOC_COUNT, otherwise it is 0.
+ */
+unsigned long long cm_alloc_count()
+{
+#ifdef CM_ALLOC_COUNT
+   return g_alloc_count;
+#else
+   return 0;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+//  Class CCmArena Implement Section
+//-----------------------------------------------------------------------------
+CCmArena::CCmArena(size_t blksiz)
+: m_blksiz(blksiz)
+, m_cur(0)
+, m_pos(0)
+{
+}
+
+CCmArena::~CCmArena()
+{
+   for (auto& e : m_blocks)
+   {
+      std::free(e.addr);
+   }
+}
+
+/*!
+ *  \brief  allocate n bytes aligned by align, which is a power of 2
+ */
+void* CCmArena::alloc(size_t n, size_t align)
+{
+   while ( m_cur < m_blocks.size() )
+   {
+      auto& blk = m_blocks[m_cur];
+      size_t pos = (m_pos + align - 1) & ~(align - 1);
+      if ( pos + n <= blk.size )
+      {
+         m_pos = pos + n;
+         return blk.addr + pos;
+      }
+
+      // the block is used up, go on with the next one
+      m_cur++;
+      m_pos = 0;
+   }
+
+   block blk;
+   blk.size = std::max(m_blksiz, n + align);
+   blk.addr = static_cast<char*>(std::malloc(blk.size));
+   if ( ! blk.addr )
+   {
+      throw std::bad_alloc();
+   }
+   m_blocks.push_back(blk);
+   m_cur = m_blocks.size() - 1;
+   m_pos = 0;
+
+   return alloc(n, align);
+}
+
+CCmStrView CCmArena::copy(const CCmStrView& s)
+{
+   char* p = alloc_text(s.len + 1);
+   std::copy(s.begin(), s.end(), p);
+   p[s.len] = '\0';
+   return CCmStrView(p, s.len);
+}
+
+void CCmArena::reset()
+{
+   m_cur = 0;
+   m_pos = 0;
+}
+
+size_t CCmArena::used() const
+{
+   size_t n = m_pos;
+   for (size_t i = 0; i < m_cur && i < m_blocks.size(); ++i)
+   {
+      n += m_blocks[i].size;
+   }
+   return n;
+}
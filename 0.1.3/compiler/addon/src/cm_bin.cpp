@@ -0,0 +1,1138 @@
+/*!
+ *    \file  cm_bin.cpp
+ *   \brief  bin file reader implement
+ *
+ *  decode the compiled bin files by the documented layouts, and compare two
+ *  of them field by field.
+ *
+ *  \author  Wang Xiaolong (WXL), wangxl3@mapbar.com
+ *
+ *  \internal
+ *       Created:  10/19/2026
+ *      Revision:  none
+ *      Compiler:  gcc
+ *  Organization:  mapbar co.
+ *     Copyright:  mapbar
+ *
+ *  This source code is released for free distribution under the terms of the
+ *  GNU General Public License as published by the Free Software Foundation.
+ */
+
+//-----------------------------------------------------------------------------
+//  Header Section
+//-----------------------------------------------------------------------------
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <algorithm>
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "cm_bin.hpp"
+#include "cm_debug.h"
+
+//-----------------------------------------------------------------------------
+//  Macro Defination Section
+//-----------------------------------------------------------------------------
+#define LOG_HEADER "[CM_BIN]"
+
+//-----------------------------------------------------------------------------
+//  Constants Defination
+//-----------------------------------------------------------------------------
+static const size_t CR_SIZE            = 16;
+static const size_t TOLL_ETA_SIZE      = 8;
+static const size_t TOLL_PATTERN_SIZE  = 16;
+static const size_t HW_JUNCTION_SIZE   = 24;
+static const size_t C_CR_TOLL_UNIT     = 16;
+static const uint64_t C_CR_TOLL_FLAG_DICT = 0x01;
+static const uint64_t C_CR_TOLL_FLAG_TILE = 0x02;
+static const uint64_t C_CR_TOLL_FLAG_SLOT = 0x04;
+static const uint64_t C_CR_TOLL_FLAG_VEH  = 0x08;
+static const size_t VP_SLOT_DAYS       = 7;
+static const size_t VP_SLOT_NUM        = 96;   ///< of a day
+static const size_t VP_SLOT_SIZE       = 88;   ///< the bitmap and the dates of an entry
+static const size_t VEH_CLASSES        = 32;
+static const size_t VEH_ARRAY_MAX      = 4096; ///< the most values of an array container
+static const size_t TILE_UNIT          = 16;
+static const uint64_t TILE_MAGIC       = 0x4C49544D;   ///< "MTIL"
+static const size_t N_HEADER_SIZE      = 16;
+
+//-----------------------------------------------------------------------------
+//  Local Utility
+//-----------------------------------------------------------------------------
+/// \brief get the little endian bit field [pos, pos + len) of the bytes
+static uint64_t _bits(const char* p, size_t pos, size_t len)
+{
+   auto b = reinterpret_cast<const unsigned char*>(p) + pos / 8;
+   size_t shift = pos % 8;
+   size_t nbytes = (shift + len + 7) / 8;
+
+   uint64_t v = b[0] >> shift;
+   for (size_t k = 1; k < nbytes; ++k)
+   {
+      auto sh = 8 * k - shift;
+      if ( sh < 64 )
+      {
+         v |= static_cast<uint64_t>(b[k]) << sh;
+      }
+   }
+
+   if ( len < 64 )
+   {
+      v &= (static_cast<uint64_t>(1) << len) - 1;
+   }
+   return v;
+}
+
+/// \brief the 16 bytes units of the CRs of C-CR-Toll, the indexes of the dictionary are 2 bytes padded to 16 bytes
+static size_t _cr_units(bool cr_dict, size_t cnt)
+{
+   return cr_dict ? (2 * cnt + C_CR_TOLL_UNIT - 1) / C_CR_TOLL_UNIT : cnt;
+}
+
+static void _push(std::vector<CCmBin::field>& v, const std::string& name, uint64_t val)
+{
+   CCmBin::field f = {name, val};
+   v.push_back(std::move(f));
+}
+
+/// \brief get the bit field [pos, pos + len) of the value
+static uint64_t _field(uint64_t v, size_t pos, size_t len)
+{
+   return (v >> pos) & ((static_cast<uint64_t>(1) << len) - 1);
+}
+
+/// \brief decode the VPeriod16/VPeriod32 pair by the VPeriod type
+static void _decode_vperiod(std::vector<CCmBin::field>& v, const std::string& pfx,
+   uint64_t type, uint64_t peri16, uint64_t peri32)
+{
+   switch(type)
+   {
+      case 1:
+         _push(v, pfx + "VPeriod16 start month",   _field(peri16, 0, 4));
+         _push(v, pfx + "VPeriod16 end month",     _field(peri16, 4, 4));
+         _push(v, pfx + "VPeriod32 start day",     _field(peri32, 0, 5));
+         _push(v, pfx + "VPeriod32 end day",       _field(peri32, 5, 5));
+         break;
+
+      case 2:
+         _push(v, pfx + "VPeriod32 weekday",       _field(peri32, 0, 7));
+         break;
+
+      default:
+         break;
+   }
+
+   if ( type >= 1 && type <= 3 )
+   {
+      _push(v, pfx + "VPeriod32 start hour",     _field(peri32, 10, 5));
+      _push(v, pfx + "VPeriod32 end hour",       _field(peri32, 15, 5));
+      _push(v, pfx + "VPeriod32 start minute",   _field(peri32, 20, 6));
+      _push(v, pfx + "VPeriod32 end minute",     _field(peri32, 26, 6));
+   }
+}
+
+const char* CCmBin::type_name(type t)
+{
+   switch(t)
+   {
+      case CCmBin::BIN_CR:             return "CR";
+      case CCmBin::BIN_TOLL_ETA:       return "Toll_ETA";
+      case CCmBin::BIN_TOLL_PATTERN:   return "Toll_Pattern";
+      case CCmBin::BIN_HW_JUNCTION:    return "HW_Junction";
+      case CCmBin::BIN_C_CR_TOLL:      return "C_CR_Toll";
+      case CCmBin::BIN_N:              return "N";
+      default:                         return "unknown";
+   }
+}
+
+//-----------------------------------------------------------------------------
+//  Class CCmBin Implement Section
+//-----------------------------------------------------------------------------
+CCmBin::CCmBin()
+: m_type(BIN_UNKNOWN)
+, m_map(nullptr)
+, m_data(nullptr)
+, m_size(0)
+, m_dict(nullptr)
+, m_dictnum(0)
+, m_slots(nullptr)
+, m_slotnum(0)
+, m_slotsiz(0)
+, m_veh(nullptr)
+, m_attr(nullptr)
+, m_nbr_off(nullptr)
+, m_nbr(nullptr)
+, m_link_off(nullptr)
+, m_link(nullptr)
+{
+}
+
+CCmBin::~CCmBin()
+{
+#if defined(__linux__)
+   if ( m_map )
+   {
+      munmap(m_map, m_size);
+   }
+#endif
+}
+
+uint64_t CCmBin::bits(const char* p, size_t pos, size_t len)
+{
+   return _bits(p, pos, len);
+}
+
+/*!
+ *  \brief  guess the bin type by the file base name
+ */
+CCmBin::type CCmBin::guess(const char* path)
+{
+   type t = BIN_UNKNOWN;
+   if ( path )
+   {
+      std::string bname = path;
+      auto pos = bname.find_last_of('/');
+      if ( std::string::npos != pos )
+      {
+         bname.erase(0, pos + 1);
+      }
+
+      auto lead = [&bname](const char* s){return 0 == bname.compare(0, std::char_traits<char>::length(s), s);};
+      if ( std::string::npos != bname.find("_C_CR_Toll") )
+      {
+         t = BIN_C_CR_TOLL;
+      }
+      else if ( lead("HW_Junction") )
+      {
+         t = BIN_HW_JUNCTION;
+      }
+      else if ( lead("Toll_ETA") )
+      {
+         t = BIN_TOLL_ETA;
+      }
+      else if ( lead("Toll_Pattern") )
+      {
+         t = BIN_TOLL_PATTERN;
+      }
+      else if ( lead("CR") )
+      {
+         t = BIN_CR;
+      }
+      else if ( lead("N") )
+      {
+         t = BIN_N;
+      }
+   }
+
+   return t;
+}
+
+bool CCmBin::load(const char* path, type t)
+{
+   bool ok = false;
+   m_type = (BIN_UNKNOWN == t) ? guess(path) : t;
+   if ( BIN_UNKNOWN != m_type )
+   {
+      std::ifstream ifs(path, std::ios::binary);
+      if ( ifs.is_open() )
+      {
+         std::ostringstream os;
+         os << ifs.rdbuf();
+         m_buf  = os.str();
+         m_data = m_buf.data();
+         m_size = m_buf.size();
+         ok = index();
+      }
+      else
+      {
+         CM_LOG_ERROR("%s open \"%s\" failed!", LOG_HEADER, path);
+      }
+   }
+   else
+   {
+      CM_LOG_ERROR("%s unknown bin type of \"%s\"!", LOG_HEADER, path);
+   }
+
+   return ok;
+}
+
+/*!
+ *  \brief  map the bin file into memory instead of reading it
+ *
+ *  It falls back to load() where mmap is not available.
+ */
+bool CCmBin::map(const char* path, type t)
+{
+#if defined(__linux__)
+   bool ok = false;
+   m_type = (BIN_UNKNOWN == t) ? guess(path) : t;
+   if ( BIN_UNKNOWN != m_type )
+   {
+      int fd = open(path, O_RDONLY);
+      if ( fd >= 0 )
+      {
+         struct stat st;
+         if ( 0 == fstat(fd, &st) && st.st_size > 0 )
+         {
+            void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if ( MAP_FAILED != addr )
+            {
+               madvise(addr, st.st_size, MADV_SEQUENTIAL);
+               m_map  = addr;
+               m_data = static_cast<const char*>(addr);
+               m_size = st.st_size;
+               ok = index();
+            }
+            else
+            {
+               CM_LOG_ERROR("%s mmap \"%s\" failed!", LOG_HEADER, path);
+            }
+         }
+         else
+         {
+            // empty file is not mappable, no record in it
+            m_data = m_buf.data();
+            m_size = 0;
+            ok = index();
+         }
+         close(fd);
+      }
+      else
+      {
+         CM_LOG_ERROR("%s open \"%s\" failed!", LOG_HEADER, path);
+      }
+   }
+   else
+   {
+      CM_LOG_ERROR("%s unknown bin type of \"%s\"!", LOG_HEADER, path);
+   }
+
+   return ok;
+#else
+   return load(path, t);
+#endif
+}
+
+size_t CCmBin::header_size() const
+{
+   switch(m_type)
+   {
+      case BIN_C_CR_TOLL:  return C_CR_TOLL_UNIT;
+      case BIN_N:          return N_HEADER_SIZE;
+      default:             return 0;
+   }
+}
+
+/*!
+ *  \brief  the byte size of the record at the offset, 0 for broken record
+ */
+size_t CCmBin::record_size(size_t off) const
+{
+   size_t siz = 0;
+   const char* p = m_data + off;
+   size_t remain = m_size - off;
+
+   switch(m_type)
+   {
+      case BIN_CR:
+         siz = CR_SIZE;
+         break;
+
+      case BIN_TOLL_ETA:
+         if ( remain >= TOLL_ETA_SIZE )
+         {
+            // the lanes of lane_num and the ones after them, ext_lane
+            auto lane_num = _bits(p, 44, 4) + _bits(p, 48, 16);
+            siz = TOLL_ETA_SIZE + (lane_num + 7) / 8 * 8;
+         }
+         break;
+
+      case BIN_TOLL_PATTERN:
+         siz = TOLL_PATTERN_SIZE;
+         break;
+
+      case BIN_HW_JUNCTION:
+         siz = HW_JUNCTION_SIZE;
+         break;
+
+      case BIN_C_CR_TOLL:
+         if ( remain >= C_CR_TOLL_UNIT )
+         {
+            auto cnt_CRID = _bits(p, 84, 4);
+            auto ETA_flag = _bits(p, 88, 1);
+            auto ptn_flag = _bits(p, 89, 1);
+            auto cr_dict  = _bits(p, 90, 1);
+            auto ext_flag = _bits(p, 91, 1);
+            siz = C_CR_TOLL_UNIT * (1 + ETA_flag + ptn_flag + _cr_units(cr_dict, cnt_CRID));
+
+            // the extension block follows the CRs, a head {CR number, lane
+            // number}, the CRs and the lanes padded to 16 bytes
+            if ( ext_flag && remain < siz + C_CR_TOLL_UNIT ) {
+               siz = remain + 1;
+            }
+            else if ( ext_flag ) {
+               auto ext_CR   = _bits(p + siz, 0, 16);
+               auto ext_lane = _bits(p + siz, 16, 16);
+               siz += C_CR_TOLL_UNIT * (1 + _cr_units(cr_dict, ext_CR) + (ext_lane + C_CR_TOLL_UNIT - 1) / C_CR_TOLL_UNIT);
+            }
+         }
+         break;
+
+      default:
+         break;
+   }
+
+   return siz <= remain ? siz : 0;
+}
+
+bool CCmBin::index()
+{
+   bool ok = true;
+   m_rec.clear();
+
+   size_t off = header_size();
+   size_t recnum = std::string::npos;
+   size_t end = m_size;
+   m_dict = nullptr;
+   m_dictnum = 0;
+   m_slots = nullptr;
+   m_slotnum = 0;
+   m_slotsiz = 0;
+   m_veh = nullptr;
+   m_tile.clear();
+   if ( BIN_C_CR_TOLL == m_type && m_size >= off )
+   {
+      recnum = _bits(m_data, 0, 32);
+      if ( _bits(m_data, 64, 32) & C_CR_TOLL_FLAG_TILE )
+      {
+         // the records follow the tile directory
+         ok = index_tiles(off, true);
+      }
+      if ( _bits(m_data, 64, 32) & C_CR_TOLL_FLAG_DICT )
+      {
+         // the dictionary follows the records
+         size_t dict_off = off + C_CR_TOLL_UNIT * _bits(m_data, 32, 32);
+         m_dictnum = _bits(m_data, 96, 32);
+         if ( dict_off + C_CR_TOLL_UNIT * m_dictnum <= m_size )
+         {
+            m_dict = m_data + dict_off;
+            end = dict_off;
+         }
+         else
+         {
+            CM_LOG_WARNING("%s broken CR dictionary at byte %d.", LOG_HEADER, static_cast<int>(dict_off));
+            m_dictnum = 0;
+            ok = false;
+         }
+      }
+      if ( _bits(m_data, 64, 32) & C_CR_TOLL_FLAG_SLOT )
+      {
+         // the VPeriod slot table follows the records and the dictionary
+         size_t slot_off = off + C_CR_TOLL_UNIT * (_bits(m_data, 32, 32) + m_dictnum);
+         bool whole = slot_off + C_CR_TOLL_UNIT <= m_size;
+         m_slotnum = whole ? _bits(m_data + slot_off, 0, 32) : 0;
+         m_slotsiz = whole ? _bits(m_data + slot_off, 32, 32) : 0;
+         if ( whole && m_slotsiz >= VP_SLOT_SIZE && slot_off + C_CR_TOLL_UNIT + m_slotsiz * m_slotnum <= m_size )
+         {
+            m_slots = m_data + slot_off + C_CR_TOLL_UNIT;
+            end = std::min(end, slot_off);
+         }
+         else
+         {
+            CM_LOG_WARNING("%s broken VPeriod slot table at byte %d.", LOG_HEADER, static_cast<int>(slot_off));
+            m_slotnum = 0;
+            ok = false;
+         }
+      }
+      if ( _bits(m_data, 64, 32) & C_CR_TOLL_FLAG_VEH )
+      {
+         // the vehicle class index follows all the above
+         size_t veh_off = off + C_CR_TOLL_UNIT * (_bits(m_data, 32, 32) + m_dictnum);
+         if ( _bits(m_data, 64, 32) & C_CR_TOLL_FLAG_SLOT )
+         {
+            veh_off += C_CR_TOLL_UNIT + m_slotsiz * m_slotnum;
+         }
+         if ( index_veh(veh_off) )
+         {
+            end = std::min(end, veh_off);
+         }
+         else
+         {
+            CM_LOG_WARNING("%s broken vehicle class index at byte %d.", LOG_HEADER, static_cast<int>(veh_off));
+            ok = false;
+         }
+      }
+   }
+   else if ( BIN_HW_JUNCTION == m_type )
+   {
+      index_tiles(off, false);
+   }
+
+   if ( BIN_N == m_type )
+   {
+      return index_N();
+   }
+
+   while ( off < end && m_rec.size() < recnum )
+   {
+      auto siz = record_size(off);
+      if ( 0 == siz )
+      {
+         CM_LOG_WARNING("%s broken %s record at byte %zu.", LOG_HEADER, type_name(m_type), off);
+         ok = false;
+         break;
+      }
+
+      record rec = {off, siz};
+      m_rec.push_back(rec);
+      off += siz;
+   }
+
+   return ok;
+}
+
+/*!
+ *  \brief  locate the sections of the N bin, every node is a record of 8 bytes
+ *
+ *  The sections follow the header in order, each padded to 16 bytes : the
+ *  node IDs, the attributes, the neighbor offsets, the neighbors, the link
+ *  offsets and the links.
+ */
+bool CCmBin::index_N()
+{
+   bool ok = m_size >= N_HEADER_SIZE;
+   if ( ok )
+   {
+      size_t node_num = _bits(m_data, 0, 32);
+      size_t nbr_num  = _bits(m_data, 32, 32);
+      size_t link_num = _bits(m_data, 64, 32);
+      auto pad = [](size_t n){ return (n + 15) / 16 * 16; };
+
+      size_t off = N_HEADER_SIZE;
+      size_t ids = off;       off += pad(8 * node_num);
+      size_t attr = off;      off += pad(4 * node_num);
+      size_t nbr_off = off;   off += pad(4 * (node_num + 1));
+      size_t nbr = off;       off += pad(8 * nbr_num);
+      size_t link_off = off;  off += pad(4 * (node_num + 1));
+      size_t link = off;      off += pad(8 * link_num);
+
+      ok = off <= m_size;
+      if ( ok )
+      {
+         m_attr     = m_data + attr;
+         m_nbr_off  = m_data + nbr_off;
+         m_nbr      = m_data + nbr;
+         m_link_off = m_data + link_off;
+         m_link     = m_data + link;
+         for (size_t i = 0; i < node_num; ++i)
+         {
+            record rec = {ids + 8 * i, 8};
+            m_rec.push_back(rec);
+         }
+      }
+      else
+      {
+         CM_LOG_WARNING("%s broken N bin, %d bytes expected.", LOG_HEADER, static_cast<int>(off));
+      }
+   }
+
+   return ok;
+}
+
+/*!
+ *  \brief  read the tile directory at the offset, which is moved after it
+ *
+ *  The tiles are the records from the offset of the entry to the one of the
+ *  next entry, the first right after the directory. The HW Junction bin has no header to flag its directory, so it is taken as
+ *  tiled only if the magic matches and the tiles end at the end of the file.
+ *  \param flagged the header says there is the directory
+ */
+bool CCmBin::index_tiles(size_t& off, bool flagged)
+{
+   bool ok = off + TILE_UNIT <= m_size && TILE_MAGIC == _bits(m_data + off, 0, 32);
+   size_t num = ok ? _bits(m_data + off, 32, 32) : 0;
+   size_t first = off + TILE_UNIT * (num + 2);
+   ok = ok && first <= m_size;
+
+   std::vector<tile> dir;
+   size_t end = first;
+   for (size_t i = 0; ok && i <= num; ++i)
+   {
+      const char* e = m_data + off + TILE_UNIT * (i + 1);
+      size_t pos = _bits(e, 64, 64);
+      ok = ( 0 == i ) ? pos == first : ( pos >= end && pos <= m_size );
+      if ( ok && i > 0 ) {
+         dir.back().size = pos - end;
+      }
+      if ( ok && i < num ) {
+         tile t = {static_cast<uint32_t>(_bits(e, 0, 32)), _bits(e, 32, 32), pos, 0};
+         dir.push_back(t);
+      }
+      end = pos;
+   }
+   ok = ok && ( flagged || end == m_size );
+
+   if ( ok )
+   {
+      m_tile.swap(dir);
+      off = first;
+   }
+   else if ( flagged )
+   {
+      CM_LOG_WARNING("%s broken tile directory at byte %d.", LOG_HEADER, static_cast<int>(off));
+   }
+   return ok;
+}
+
+/*!
+ *  \brief  check the vehicle class index at the offset
+ *
+ *  Every class in the directory is in the index, so are its containers.
+ */
+bool CCmBin::index_veh(size_t off)
+{
+   if ( off + C_CR_TOLL_UNIT + 8 * VEH_CLASSES > m_size || VEH_CLASSES != _bits(m_data + off, 0, 32) )
+   {
+      return false;
+   }
+
+   const char* veh = m_data + off;
+   size_t bytes = _bits(veh, 32, 32);
+   if ( off + bytes > m_size )
+   {
+      return false;
+   }
+   for (size_t b = 0; b < VEH_CLASSES; ++b)
+   {
+      size_t boff = _bits(veh, 128 + 64 * b, 32);
+      if ( 0 == _bits(veh, 160 + 64 * b, 32) ) {
+         continue;
+      }
+      if ( boff + 8 > bytes ) {
+         return false;
+      }
+      const char* bmp = veh + boff;
+      size_t n = _bits(bmp, 0, 32);
+      if ( boff + 8 + 8 * n > bytes ) {
+         return false;
+      }
+      for (size_t k = 0; k < n; ++k)
+      {
+         size_t card = _bits(bmp, 64 + 64 * k + 16, 16) + 1;
+         size_t len = card > VEH_ARRAY_MAX ? 8192 : 2 * card;
+         if ( boff + _bits(bmp, 64 + 64 * k + 32, 32) + len > bytes ) {
+            return false;
+         }
+      }
+   }
+
+   m_veh = veh;
+   return true;
+}
+
+/// \brief the number of the records of the vehicle class
+size_t CCmBin::veh_count(size_t cls) const
+{
+   return m_veh && cls < VEH_CLASSES ? _bits(m_veh, 160 + 64 * cls, 32) : 0;
+}
+
+/*!
+ *  \brief  if the record of the ordinal has a CR of the vehicle class
+ *
+ *  The container of the high 16 bits is searched by binary search, then the
+ *  low 16 bits in it.
+ */
+bool CCmBin::veh_contains(size_t cls, size_t ordinal) const
+{
+   if ( 0 == veh_count(cls) || ordinal > 0xFFFFFFFF )
+   {
+      return false;
+   }
+
+   const char* bmp = m_veh + _bits(m_veh, 128 + 64 * cls, 32);
+   size_t key = ordinal >> 16, low = ordinal & 0xFFFF;
+   size_t lo = 0, hi = _bits(bmp, 0, 32);
+   while ( lo < hi )
+   {
+      size_t mid = (lo + hi) / 2;
+      if ( _bits(bmp, 64 + 64 * mid, 16) < key ) {
+         lo = mid + 1;
+      }
+      else {
+         hi = mid;
+      }
+   }
+   if ( lo == _bits(bmp, 0, 32) || _bits(bmp, 64 + 64 * lo, 16) != key )
+   {
+      return false;
+   }
+
+   size_t card = _bits(bmp, 64 + 64 * lo + 16, 16) + 1;
+   const char* c = bmp + _bits(bmp, 64 + 64 * lo + 32, 32);
+   if ( card > VEH_ARRAY_MAX )
+   {
+      return 0 != _bits(c, low, 1);
+   }
+   lo = 0, hi = card;
+   while ( lo < hi )
+   {
+      size_t mid = (lo + hi) / 2;
+      if ( _bits(c, 16 * mid, 16) < low ) {
+         lo = mid + 1;
+      }
+      else {
+         hi = mid;
+      }
+   }
+   return lo < card && _bits(c, 16 * lo, 16) == low;
+}
+
+/// \brief the ordinals of the records of the vehicle class, ascending
+void CCmBin::veh_records(size_t cls, std::vector<size_t>& ord) const
+{
+   ord.clear();
+   if ( 0 == veh_count(cls) )
+   {
+      return;
+   }
+
+   const char* bmp = m_veh + _bits(m_veh, 128 + 64 * cls, 32);
+   ord.reserve(veh_count(cls));
+   for (size_t k = 0, n = _bits(bmp, 0, 32); k < n; ++k)
+   {
+      size_t high = _bits(bmp, 64 + 64 * k, 16) << 16;
+      size_t card = _bits(bmp, 64 + 64 * k + 16, 16) + 1;
+      const char* c = bmp + _bits(bmp, 64 + 64 * k + 32, 32);
+      if ( card > VEH_ARRAY_MAX )
+      {
+         for (size_t low = 0; low < 65536; ++low)
+         {
+            if ( _bits(c, low, 1) ) {
+               ord.push_back(high | low);
+            }
+         }
+      }
+      else
+      {
+         for (size_t i = 0; i < card; ++i)
+         {
+            ord.push_back(high | _bits(c, 16 * i, 16));
+         }
+      }
+   }
+}
+
+void CCmBin::decode_header(std::vector<field>& v) const
+{
+   v.clear();
+   if ( BIN_N == m_type && m_size >= header_size() )
+   {
+      _push(v, "header.node_num", _bits(m_data, 0, 32));
+      _push(v, "header.nbr_num",  _bits(m_data, 32, 32));
+      _push(v, "header.link_num", _bits(m_data, 64, 32));
+   }
+   else if ( header_size() > 0 && m_size >= header_size() )
+   {
+      _push(v, "header.recnum",   _bits(m_data, 0, 32));
+      _push(v, "header.datsiz",   _bits(m_data, 32, 32));
+      _push(v, "header.flags",    _bits(m_data, 64, 32));
+      _push(v, "header.dictnum",  _bits(m_data, 96, 32));
+   }
+
+   for (size_t i = 0; i < m_tile.size(); ++i)
+   {
+      auto pfx = "tile[" + std::to_string(i) + "].";
+      _push(v, pfx + "MapID",  m_tile[i].mapid);
+      _push(v, pfx + "recnum", m_tile[i].recnum);
+      _push(v, pfx + "size",   m_tile[i].size);
+   }
+
+   for (size_t b = 0; m_veh && b < VEH_CLASSES; ++b)
+   {
+      _push(v, "veh[" + std::to_string(b) + "].count", veh_count(b));
+   }
+}
+
+void CCmBin::decode(const record& rec, std::vector<field>& v) const
+{
+   v.clear();
+   const char* p = m_data + rec.offset;
+   switch(m_type)
+   {
+      case BIN_CR:
+      {
+         auto type = _bits(p, 44, 4);
+         auto p16  = _bits(p, 48, 16);
+         auto p32  = _bits(p, 64, 32);
+         _push(v, "CRID",        _bits(p, 0, 40));
+         _push(v, "VPDir",       _bits(p, 40, 2));
+         _push(v, "VP_Approx",   _bits(p, 42, 2));
+         _push(v, "VPeri_Type",  type);
+         _push(v, "VPeriod16",   p16);
+         _push(v, "VPeriod32",   p32);
+         _push(v, "Vehcl_Type",  _bits(p, 96, 32));
+         _decode_vperiod(v, "", type, p16, p32);
+         break;
+      }
+
+      case BIN_TOLL_ETA:
+      {
+         auto lane_num = _bits(p, 44, 4);
+         auto ext_lane = _bits(p, 48, 16);
+         _push(v, "CondID",   _bits(p, 0, 40));
+         _push(v, "TollType", _bits(p, 40, 4));
+         _push(v, "lane_num", lane_num);
+         if ( ext_lane > 0 )
+         {
+            _push(v, "ext_lane", ext_lane);
+         }
+         for (size_t i = 0; i < lane_num + ext_lane; ++i)
+         {
+            _push(v, "lane[" + std::to_string(i) + "]", _bits(p + TOLL_ETA_SIZE, 8 * i, 8));
+         }
+         break;
+      }
+
+      case BIN_TOLL_PATTERN:
+         _push(v, "CondID",   _bits(p, 0, 40));
+         _push(v, "PatterNo", _bits(p, 64, 32));
+         _push(v, "ArrowNo",  _bits(p, 96, 32));
+         break;
+
+      case BIN_HW_JUNCTION:
+         _push(v, "ID",          _bits(p, 0, 40));
+         _push(v, "AccessType",  _bits(p, 48, 4));
+         _push(v, "Attr",        _bits(p, 52, 4));
+         _push(v, "Estab_item",  _bits(p, 56, 8));
+         _push(v, "NodeID",      _bits(p, 64, 40));
+         _push(v, "inLinkID",    _bits(p, 104, 40));
+         _push(v, "outLinkID",   _bits(p, 144, 40));
+         break;
+
+      case BIN_C_CR_TOLL:
+      {
+         auto cnt_CRID = _bits(p, 84, 4);
+         auto ETA_flag = _bits(p, 88, 1);
+         auto ptn_flag = _bits(p, 89, 1);
+         auto cr_dict  = _bits(p, 90, 1);
+         auto ext_flag = _bits(p, 91, 1);
+         _push(v, "InLinkId",  _bits(p, 0, 40));
+         _push(v, "OutLinkId", _bits(p, 40, 40));
+         _push(v, "CondType",  _bits(p, 80, 4));
+         _push(v, "cnt_CRID",  cnt_CRID);
+         _push(v, "ETA_flag",  ETA_flag);
+         _push(v, "ptn_flag",  ptn_flag);
+         _push(v, "cr_dict",   cr_dict);
+         if ( ext_flag ) {
+            _push(v, "ext_flag", ext_flag);
+         }
+         p += C_CR_TOLL_UNIT;
+
+         size_t lane_num = 0;
+         if ( ETA_flag )
+         {
+            lane_num = _bits(p, 4, 4);
+            _push(v, "ETA.type",     _bits(p, 0, 4));
+            _push(v, "ETA.lane_num", lane_num);
+            for (size_t i = 0; i < lane_num && i < 15; ++i)
+            {
+               _push(v, "ETA.lane[" + std::to_string(i) + "]", _bits(p, 8 * (i + 1), 8));
+            }
+            p += C_CR_TOLL_UNIT;
+         }
+
+         if ( ptn_flag )
+         {
+            _push(v, "Pattern.PatterNo", _bits(p, 0, 32));
+            _push(v, "Pattern.ArrowNo",  _bits(p, 32, 32));
+            p += C_CR_TOLL_UNIT;
+         }
+
+         // the CRs referred by index are decoded from the dictionary, the
+         // same as the inline ones
+         auto decode_CR = [&](size_t i, const char* blk, size_t k)
+         {
+            const char* cr = blk + C_CR_TOLL_UNIT * k;
+            if ( cr_dict )
+            {
+               auto idx = _bits(blk, 16 * k, 16);
+               if ( idx >= m_dictnum )
+               {
+                  CM_LOG_WARNING("%s CR index %d out of the dictionary.", LOG_HEADER, static_cast<int>(idx));
+                  return;
+               }
+               cr = m_dict + C_CR_TOLL_UNIT * idx;
+            }
+
+            auto pfx  = "CR[" + std::to_string(i) + "].";
+            auto type = _bits(cr, 4, 4);
+            auto p16  = _bits(cr, 48, 16);
+            auto p32  = _bits(cr, 64, 32);
+            _push(v, pfx + "VPDir",       _bits(cr, 0, 2));
+            _push(v, pfx + "VP_Approx",   _bits(cr, 2, 2));
+            _push(v, pfx + "VPeri_Type",  type);
+            _push(v, pfx + "VPeriod16",   p16);
+            _push(v, pfx + "VPeriod32",   p32);
+            _push(v, pfx + "Vehcl_Type",  _bits(cr, 96, 32));
+            _decode_vperiod(v, pfx, type, p16, p32);
+            if ( m_slots )
+            {
+               decode_slot(v, pfx, _bits(cr, 8, 16));
+            }
+         };
+         for (size_t i = 0; i < cnt_CRID; ++i)
+         {
+            decode_CR(i, p, i);
+         }
+
+         // the CRs and the lanes of the extension block follow the ones above
+         if ( ext_flag )
+         {
+            p += C_CR_TOLL_UNIT * _cr_units(cr_dict, cnt_CRID);
+            auto ext_CR   = _bits(p, 0, 16);
+            auto ext_lane = _bits(p, 16, 16);
+            _push(v, "ext.cnt_CRID", ext_CR);
+            _push(v, "ext.lane_num", ext_lane);
+            p += C_CR_TOLL_UNIT;
+            for (size_t k = 0; k < ext_CR; ++k)
+            {
+               decode_CR(cnt_CRID + k, p, k);
+            }
+            p += C_CR_TOLL_UNIT * _cr_units(cr_dict, ext_CR);
+            for (size_t k = 0; k < ext_lane; ++k)
+            {
+               _push(v, "ETA.lane[" + std::to_string(lane_num + k) + "]", _bits(p, 8 * k, 8));
+            }
+         }
+
+         // the classes of the record in the index, by its ordinal
+         if ( m_veh )
+         {
+            auto it = std::lower_bound(m_rec.begin(), m_rec.end(), rec.offset,
+               [](const record& r, size_t off){return r.offset < off;});
+            uint64_t mask = 0;
+            for (size_t b = 0; m_rec.end() != it && b < VEH_CLASSES; ++b)
+            {
+               if ( veh_contains(b, it - m_rec.begin()) ) {
+                  mask |= 1ull << b;
+               }
+            }
+            _push(v, "veh_classes", mask);
+         }
+         break;
+      }
+
+      case BIN_N:
+      {
+         size_t i = (rec.offset - N_HEADER_SIZE) / 8;
+         _push(v, "ID",          _bits(p, 0, 40));
+         _push(v, "Cross_flag",  _bits(m_attr, 32 * i, 4));
+         _push(v, "Light_flag",  _bits(m_attr, 32 * i + 4, 4));
+         _push(v, "MapID",       _bits(m_attr, 32 * i + 8, 24));
+
+         auto first = _bits(m_nbr_off, 32 * i, 32), last = _bits(m_nbr_off, 32 * (i + 1), 32);
+         for (auto k = first; k < last; ++k)
+         {
+            auto pfx = "nbr[" + std::to_string(k - first) + "].";
+            _push(v, pfx + "ID",     _bits(m_nbr, 64 * k, 40));
+            _push(v, pfx + "kind",   _bits(m_nbr, 64 * k + 40, 4));
+            _push(v, pfx + "MapID",  _bits(m_nbr, 64 * k + 44, 20));
+         }
+
+         first = _bits(m_link_off, 32 * i, 32), last = _bits(m_link_off, 32 * (i + 1), 32);
+         for (auto k = first; k < last; ++k)
+         {
+            _push(v, "link[" + std::to_string(k - first) + "]", _bits(m_link, 64 * k, 64));
+         }
+         break;
+      }
+
+      default:
+         break;
+   }
+}
+
+/*!
+ *  \brief  decode the entry of the VPeriod slot table referred by the CR
+ *
+ *  The 96 slots of a day are split into 2 fields, the slots 0~63 and 64~95.
+ */
+void CCmBin::decode_slot(std::vector<field>& v, const std::string& pfx, size_t idx) const
+{
+   _push(v, pfx + "vp_slot", idx);
+   if ( idx >= m_slotnum )
+   {
+      return;
+   }
+
+   const char* e = m_slots + m_slotsiz * idx;
+   const size_t dates = VP_SLOT_DAYS * VP_SLOT_NUM;
+   _push(v, pfx + "slot.start month", _bits(e, dates, 8));
+   _push(v, pfx + "slot.start day",   _bits(e, dates + 8, 8));
+   _push(v, pfx + "slot.end month",   _bits(e, dates + 16, 8));
+   _push(v, pfx + "slot.end day",     _bits(e, dates + 24, 8));
+   for (size_t d = 0; d < VP_SLOT_DAYS; ++d)
+   {
+      auto day = pfx + "slot.day" + std::to_string(d);
+      _push(v, day + " 0~63",  _bits(e, VP_SLOT_NUM * d, 64));
+      _push(v, day + " 64~95", _bits(e, VP_SLOT_NUM * d + 64, 32));
+   }
+}
+
+//-----------------------------------------------------------------------------
+//  Compare Section
+//-----------------------------------------------------------------------------
+/*!
+ *  \brief  report the fields differed of one record
+ *  \param what the prefix of the reported lines, such as "record 17"
+ *  \param quota the maximum number of the lines to report
+ *  \return the number of the reported lines
+ */
+size_t CCmBin::compare(const std::string& what,
+   const std::vector<field>& a, const std::vector<field>& b, size_t quota)
+{
+   size_t num = 0;
+   std::map<std::string, uint64_t> ma, mb;
+   for (const auto& e : a) ma[e.name] = e.value;
+   for (const auto& e : b) mb[e.name] = e.value;
+
+   for (const auto& e : a)
+   {
+      if ( num >= quota )
+      {
+         break;
+      }
+
+      auto it = mb.find(e.name);
+      if ( mb.end() == it )
+      {
+         CM_LOG_INFO("%s %s, %s %llu -> (none)", LOG_HEADER, what.c_str(), e.name.c_str(),
+            static_cast<unsigned long long>(e.value));
+         num++;
+      }
+      else if ( it->second != e.value )
+      {
+         CM_LOG_INFO("%s %s, %s %llu -> %llu", LOG_HEADER, what.c_str(), e.name.c_str(),
+            static_cast<unsigned long long>(e.value), static_cast<unsigned long long>(it->second));
+         num++;
+      }
+   }
+
+   for (const auto& e : b)
+   {
+      if ( num >= quota )
+      {
+         break;
+      }
+
+      if ( ma.end() == ma.find(e.name) )
+      {
+         CM_LOG_INFO("%s %s, %s (none) -> %llu", LOG_HEADER, what.c_str(), e.name.c_str(),
+            static_cast<unsigned long long>(e.value));
+         num++;
+      }
+   }
+
+   return num;
+}
+
+/*!
+ *  \brief  compare a bin file with its golden one, record by record
+ *
+ *  The differences are reported by the decoded fields, such as
+ *  "record 17, CR[2].VPeriod32 start hour 7 -> 8". The bytes differed
+ *  out of any decoded field (padding, reserved) are reported by offset.
+ *  \param golden the path of the expected bin
+ *  \param path the path of the bin to check
+ *  \param max_report the maximum lines of the reported differences
+ *  \return EXIT_SUCCESS if the files are the same byte by byte.
+ */
+int cm_bin_compare(const char* golden, const char* path, size_t max_report)
+{
+   CCmBin exp, cur;
+   auto t = CCmBin::guess(golden);
+   if ( ! exp.load(golden, t) || ! cur.load(path, t) )
+   {
+      CM_LOG_ERROR("%s load \"%s\" or \"%s\" failed!", LOG_HEADER, golden, path);
+      return EXIT_FAILURE;
+   }
+
+   if ( exp.size() == cur.size() && std::equal(exp.data(), exp.data() + exp.size(), cur.data()) )
+   {
+      CM_LOG_INFO("%s %s : identical, %zu records.", LOG_HEADER, path, exp.records().size());
+      return EXIT_SUCCESS;
+   }
+
+   size_t num = 0;
+   std::vector<CCmBin::field> fa, fb;
+   exp.decode_header(fa);
+   cur.decode_header(fb);
+   num += CCmBin::compare("header", fa, fb, max_report);
+
+   const auto& ra = exp.records();
+   const auto& rb = cur.records();
+   auto n = std::max(ra.size(), rb.size());
+   for (size_t i = 0; i < n && num < max_report; ++i)
+   {
+      std::string what = "record " + std::to_string(i);
+      if ( i >= ra.size() )
+      {
+         CM_LOG_INFO("%s %s, only in \"%s\"", LOG_HEADER, what.c_str(), path);
+         num++;
+         continue;
+      }
+      else if ( i >= rb.size() )
+      {
+         CM_LOG_INFO("%s %s, only in \"%s\"", LOG_HEADER, what.c_str(), golden);
+         num++;
+         continue;
+      }
+
+      const auto& a = ra[i];
+      const auto& b = rb[i];
+      const char* pa = exp.data() + a.offset;
+      const char* pb = cur.data() + b.offset;
+      // a record may refer to the data out of it, such as the dictionary
+      bool same = a.size == b.size && std::equal(pa, pa + a.size, pb);
+      if ( same && ! exp.refers_out() && ! cur.refers_out() )
+      {
+         continue;
+      }
+
+      exp.decode(a, fa);
+      cur.decode(b, fb);
+      auto diff = CCmBin::compare(what, fa, fb, max_report - num);
+      if ( 0 == diff && ! same )
+      {
+         // the difference is out of the decoded fields
+         auto m = std::mismatch(pa, pa + std::min(a.size, b.size), pb);
+         auto pos = std::distance(pa, m.first);
+         CM_LOG_INFO("%s %s, byte %zu (undecoded) 0x%02x -> 0x%02x", LOG_HEADER, what.c_str(), static_cast<size_t>(pos),
+            static_cast<unsigned char>(pa[pos]), static_cast<unsigned char>(pb[pos]));
+         diff = 1;
+      }
+      num += diff;
+   }
+
+   if ( 0 == num )
+   {
+      // the difference is out of the records
+      auto len = std::min(exp.size(), cur.size());
+      auto m = std::mismatch(exp.data(), exp.data() + len, cur.data());
+      CM_LOG_INFO("%s byte %zu out of records, size %zu -> %zu", LOG_HEADER,
+         static_cast<size_t>(std::distance(exp.data(), m.first)), exp.size(), cur.size());
+   }
+
+   if ( num >= max_report )
+   {
+      CM_LOG_INFO("%s ... stopped at %zu differences.", LOG_HEADER, num);
+   }
+   CM_LOG_INFO("%s %s : differs from \"%s\", %zu / %zu records.", LOG_HEADER, path, golden, rb.size(), ra.size());
+
+   return EXIT_FAILURE;
+}
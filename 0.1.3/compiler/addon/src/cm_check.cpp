@@ -0,0 +1,205 @@
+/*!
+ *    \file  cm_check.cpp
+ *   \brief  referential integrity validator implement
+ *
+ *  the keys of CR, Toll_ETA and Toll_Pattern are loaded into the hash sets on
+ *  the threads, and the references of C are probed by them.
+ *
+ *  \author  Wang Xiaolong (WXL), wangxl3@mapbar.com
+ *
+ *  \internal
+ *       Created:  10/19/2026
+ *      Revision:  none
+ *      Compiler:  gcc
+ *  Organization:  mapbar co.
+ *     Copyright:  mapbar
+ *
+ *  This source code is released for free distribution under the terms of the
+ *  GNU General Public License as published by the Free Software Foundation.
+ */
+
+//-----------------------------------------------------------------------------
+//  Header Section
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include "cm_check.hpp"
+#include "cm_debug.h"
+
+//-----------------------------------------------------------------------------
+//  MACRO Defination
+//-----------------------------------------------------------------------------
+#define LOG_HEADER "[CM_CHECK]"
+
+//-----------------------------------------------------------------------------
+//  Constants Defination
+//-----------------------------------------------------------------------------
+static const size_t SAMPLE_NUM = 8;       ///< the samples kept of an issue
+
+static const char* const g_table_name[CCmValidator::TABLE_NUM] = {
+   "CR", "Toll ETA", "Toll pattern",
+};
+
+static const char* const g_issue_name[CCmValidator::ISSUE_NUM] = {
+   "CRIDs of C not in CR",
+   "CondIDs of C in neither Toll ETA nor Toll pattern",
+   "CondIDs of more than one Toll ETA",
+   "CondIDs of more than one Toll pattern",
+   "C rows of the CRs truncated",
+   "C rows of the Toll ETA dropped for the lanes",
+   "C rows of the Toll ETA lanes truncated",
+};
+
+//-----------------------------------------------------------------------------
+//  Class CCmKeySet Implement Section
+//-----------------------------------------------------------------------------
+void CCmKeySet::add(const CCmStrView& key, bool over)
+{
+   m_buf.assign(key.data(), key.size());
+   auto& e = m_key[m_buf];
+   if ( 0 == e.rows++ ) {
+      e.over = over;
+   }
+   m_rows++;
+}
+
+uint32_t CCmKeySet::rows(const std::string& key) const
+{
+   auto it = m_key.find(key);
+   return m_key.end() == it ? 0 : it->second.rows;
+}
+
+bool CCmKeySet::over(const std::string& key) const
+{
+   auto it = m_key.find(key);
+   return m_key.end() != it && it->second.over;
+}
+
+//-----------------------------------------------------------------------------
+//  Class CCmValidator Implement Section
+//-----------------------------------------------------------------------------
+CCmValidator::CCmValidator(size_t cr_max, bool lane_ext, size_t threads)
+: m_cr_max(cr_max)
+, m_lane_ext(lane_ext)
+, m_threads(std::max<size_t>(threads, 1))
+, m_probed(0)
+{
+}
+
+/*!
+ *  \brief  load the key sets of CR, Toll_ETA and Toll_Pattern by the loaders
+ *
+ *  Each loader fills its own set, so the sets are loaded on the threads
+ *  without a lock, and the time is about the one of the largest table.
+ */
+bool CCmValidator::load(const key_load (&loader)[TABLE_NUM])
+{
+   bool ok[TABLE_NUM] = {false};
+   std::atomic<size_t> next(0);
+   auto work = [&](){
+      for (size_t i = next++; i < TABLE_NUM; i = next++)
+      {
+         ok[i] = loader[i](m_keys[i]);
+         if ( ! ok[i] )
+         {
+            CM_LOG_ERROR("%s load the keys of %s failed!", LOG_HEADER, g_table_name[i]);
+         }
+      }
+   };
+
+   const size_t workers = std::min<size_t>(m_threads, TABLE_NUM);
+   std::vector<std::thread> pool;
+   for (size_t w = 1; w < workers; ++w)
+   {
+      pool.emplace_back(work);
+   }
+   work();
+   for (auto& t : pool)
+   {
+      t.join();
+   }
+
+   duplicated(TOLL_ETA, ETA_DUPLICATED);
+   duplicated(TOLL_PATTERN, PATTERN_DUPLICATED);
+   CM_LOG_INFO("%s keys loaded on %zu threads : CR %zu of %zu rows, Toll ETA %zu, Toll pattern %zu.", LOG_HEADER, workers,
+      m_keys[CR].size(), m_keys[CR].row_num(), m_keys[TOLL_ETA].size(), m_keys[TOLL_PATTERN].size());
+   return std::all_of(std::begin(ok), std::end(ok), [](bool b){ return b; });
+}
+
+/// \brief count the issue, the sample is made only while more of them are kept
+template<typename F>
+void CCmValidator::add(issue i, F sample)
+{
+   auto& f = m_issue[i];
+   if ( f.sample.size() < SAMPLE_NUM )
+   {
+      f.sample.push_back(sample());
+   }
+   f.count++;
+}
+
+/// \brief probe the references of the C row, the empty ones are not referred
+void CCmValidator::probe(size_t row, const CCmStrView& CRID, const CCmStrView& CondID)
+{
+   m_probed++;
+   if ( ! CRID.empty() )
+   {
+      m_key.assign(CRID.data(), CRID.size());
+      auto n = m_keys[CR].rows(m_key);
+      if ( 0 == n ) {
+         add(CRID_DANGLING, [&](){ return "CRID " + m_key + " at row " + std::to_string(row); });
+      }
+      else if ( n > m_cr_max ) {
+         add(CR_TRUNCATED, [&](){ return "CRID " + m_key + " of " + std::to_string(n) + " CRs at row " + std::to_string(row); });
+      }
+   }
+
+   if ( ! CondID.empty() )
+   {
+      m_key.assign(CondID.data(), CondID.size());
+      bool eta = m_keys[TOLL_ETA].rows(m_key) > 0;
+      if ( ! eta && 0 == m_keys[TOLL_PATTERN].rows(m_key) ) {
+         add(CONDID_DANGLING, [&](){ return "CondID " + m_key + " at row " + std::to_string(row); });
+      }
+      else if ( eta && m_keys[TOLL_ETA].over(m_key) ) {
+         add(m_lane_ext ? LANE_TRUNCATED : LANE_DROPPED, [&](){ return "CondID " + m_key + " at row " + std::to_string(row); });
+      }
+   }
+}
+
+/// \brief log the issues found with their samples, and the number of them
+void CCmValidator::report() const
+{
+   size_t total = 0;
+   for (size_t i = 0; i < ISSUE_NUM; ++i)
+   {
+      const auto& f = m_issue[i];
+      if ( f.count > 0 )
+      {
+         std::ostringstream os;
+         for (const auto& s : f.sample)
+         {
+            os << (&s == &f.sample.front() ? "" : "; ") << s;
+         }
+         CM_LOG_WARNING("%s %zu %s, e.g. %s%s", LOG_HEADER, f.count, g_issue_name[i], os.str().c_str(),
+            f.count > f.sample.size() ? " ..." : "");
+      }
+      total += f.count;
+   }
+
+   CM_LOG_INFO("%s %zu C rows probed, %zu issues found.", LOG_HEADER, m_probed, total);
+}
+
+/// \brief count the keys of the table with more than one row
+void CCmValidator::duplicated(table t, issue i)
+{
+   for (const auto& e : m_keys[t].m_key)
+   {
+      if ( e.second.rows > 1 )
+      {
+         add(i, [&](){ return "CondID " + e.first + " of " + std::to_string(e.second.rows) + " rows"; });
+      }
+   }
+}
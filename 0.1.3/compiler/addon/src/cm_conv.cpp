@@ -0,0 +1,236 @@
+/*!
+ *    \file  cm_conv.cpp
+ *   \brief  text to integer conversion implement
+ *
+ *  The digits of base 2, 10 and 16 are checked and converted 8 chars at
+ *  once in a 64 bits word (SWAR), the rest chars one by one. Nothing is
+ *  allocated and no exception is thrown.
+ *
+ *  \author  Wang Xiaolong (WXL), wangxl3@mapbar.com
+ *
+ *  \internal
+ *       Created:  10/19/2026
+ *      Revision:  none
+ *      Compiler:  gcc
+ *  Organization:  mapbar co.
+ *     Copyright:  mapbar
+ *
+ *  This source code is released for free distribution under the terms of the
+ *  GNU General Public License as published by the Free Software Foundation.
+ */
+
+//-----------------------------------------------------------------------------
+//  Header Section
+//-----------------------------------------------------------------------------
+#include <cstring>
+#include "cm_conv.hpp"
+
+//-----------------------------------------------------------------------------
+//  MACRO Defination
+//-----------------------------------------------------------------------------
+#if defined(_MSC_VER) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define CM_CONV_SWAR 1
+#else
+#define CM_CONV_SWAR 0
+#endif
+
+//-----------------------------------------------------------------------------
+//  Local Utility
+//-----------------------------------------------------------------------------
+/// \brief the value of the digit, 36 if it is not a digit of any base
+static inline unsigned _digit(char ch)
+{
+   unsigned c = static_cast<unsigned char>(ch);
+   if ( c - '0' < 10 )
+   {
+      return c - '0';
+   }
+   c |= 0x20;
+   return ( c - 'a' < 26 ) ? c - 'a' + 10 : 36;
+}
+
+#if CM_CONV_SWAR
+static const uint64_t ONES = 0x0101010101010101ULL;
+
+/// \brief 8 chars, the first one in the lowest byte
+static inline uint64_t _load8(const char* p)
+{
+   uint64_t x;
+   std::memcpy(&x, p, sizeof(x));
+   return x;
+}
+
+/// \brief the high bit of the bytes in (m, n), the bytes must be less than 128
+static inline uint64_t _between(uint64_t x, uint64_t m, uint64_t n)
+{
+   uint64_t low = x & (ONES * 127);
+   return ((ONES * (127 + n) - low) & ~x & (low + ONES * (127 - m))) & (ONES * 128);
+}
+
+/// \brief 8 decimal digits
+struct _dec8
+{
+   static const uint64_t mul = 100000000ULL;
+
+   static bool check(uint64_t x)
+   {
+      return ((x & (ONES * 0xF0)) | (((x + ONES * 0x06) & (ONES * 0xF0)) >> 4)) == ONES * 0x33;
+   }
+
+   static uint64_t value(uint64_t x)
+   {
+      x -= ONES * '0';
+      x = (x * 10) + (x >> 8);         // the pairs of the digits
+      x = (((x & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)))
+         + (((x >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+      return x;
+   }
+};
+
+/// \brief 8 binary digits
+struct _bin8
+{
+   static const uint64_t mul = 256;
+
+   static bool check(uint64_t x)
+   {
+      return (x & ~ONES) == ONES * '0';
+   }
+
+   static uint64_t value(uint64_t x)
+   {
+      // the bit of the byte i goes to the bit 63 - i
+      return ((x & ONES) * 0x8040201008040201ULL) >> 56;
+   }
+};
+
+/// \brief 8 hex digits of either case
+struct _hex8
+{
+   static const uint64_t mul = 0x100000000ULL;
+
+   static bool check(uint64_t x)
+   {
+      if ( x & (ONES * 0x80) )
+      {
+         return false;
+      }
+      uint64_t dig = _between(x, '0' - 1, '9' + 1);
+      uint64_t alp = _between(x | (ONES * 0x20), 'a' - 1, 'f' + 1);
+      return (dig | alp) == ONES * 0x80;
+   }
+
+   static uint64_t value(uint64_t x)
+   {
+      // the letters have the bit 6, and the low 4 bits are 1 to 6
+      x = (x & (ONES * 0x0F)) + ((x >> 6) & ONES) * 9;
+      x = ((x & 0x0F000F000F000F00ULL) >> 8) | ((x & 0x000F000F000F000FULL) << 4);
+      x = ((x & 0x00FF000000FF0000ULL) >> 16) | ((x & 0x000000FF000000FFULL) << 8);
+      return ((x >> 32) & 0xFFFF) | ((x & 0xFFFF) << 16);
+   }
+};
+
+/// \brief take the digits 8 chars at once while they fit, the rest are left to the caller
+template<typename T>
+static const char* _swar(const char* p, const char* last, uint64_t& v, bool& range)
+{
+   while ( last - p >= 8 )
+   {
+      uint64_t x = _load8(p);
+      if ( ! T::check(x) )
+      {
+         break;
+      }
+
+      uint64_t d = T::value(x);
+      if ( v > (UINT64_MAX - d) / T::mul )
+      {
+         range = true;
+         break;
+      }
+      v = v * T::mul + d;
+      p += 8;
+   }
+   return p;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+//  Interface Implement Section
+//-----------------------------------------------------------------------------
+CCmConvResult cm_from_chars(const char* first, const char* last, uint64_t& value, int base)
+{
+   CCmConvResult res = {first, CCmConvErr::invalid_argument};
+   if ( base < 2 || base > 36 )
+   {
+      return res;
+   }
+
+   const char* p = first;
+   uint64_t v = 0;
+   bool range = false;
+#if CM_CONV_SWAR
+   switch(base)
+   {
+      case 10:
+         p = _swar<_dec8>(p, last, v, range);
+         break;
+
+      case 16:
+         p = _swar<_hex8>(p, last, v, range);
+         break;
+
+      case 2:
+         p = _swar<_bin8>(p, last, v, range);
+         break;
+
+      default:
+         break;
+   }
+#endif
+
+   const unsigned b = static_cast<unsigned>(base);
+   for (; p < last; ++p)
+   {
+      unsigned d = _digit(*p);
+      if ( d >= b )
+      {
+         break;
+      }
+
+      if ( ! range && v > (UINT64_MAX - d) / b )
+      {
+         range = true;
+      }
+      v = range ? v : v * b + d;
+   }
+
+   if ( p != first )
+   {
+      res.ptr = p;
+      res.ec = range ? CCmConvErr::result_out_of_range : CCmConvErr::ok;
+      if ( ! range )
+      {
+         value = v;
+      }
+   }
+   return res;
+}
+
+CCmConvResult cm_from_chars(const char* first, const char* last, uint32_t& value, int base)
+{
+   uint64_t v = 0;
+   auto res = cm_from_chars(first, last, v, base);
+   if ( CCmConvErr::ok == res.ec )
+   {
+      if ( v > UINT32_MAX )
+      {
+         res.ec = CCmConvErr::result_out_of_range;
+      }
+      else
+      {
+         value = static_cast<uint32_t>(v);
+      }
+   }
+   return res;
+}
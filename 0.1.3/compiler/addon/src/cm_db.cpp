@@ -1,2148 +1,4303 @@
-/*!
- *    \file  cm_db.cpp
- *   \brief  the database implement for compiler
- *  
- *  the class routine things
- *  
- *  \author  Wang Xiaolong (WXL), wangxl3@mapbar.com
- *  
- *  \internal
- *       Created:  11/28/2016
- *      Revision:  none
- *      Compiler:  gcc
- *  Organization:  mapbar co.
- *     Copyright:  mapbar
- *  
- *  This source code is released for free distribution under the terms of the
- *  GNU General Public License as published by the Free Software Foundation.
- */
-
-/*!
- * @page pg_srch Page for search target data
- * @brief This page introduce how to search target data such as CR, toll info or HW info.
- * @section sec1 reach the CR info
- * @subsection subsec_1_1 CR info binary format
- * @brief The CR info is up to 16 bytes.
- * @details The bit sequence is like following.
- * @verbatim
-00~07 bytes: XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXXXX
-             63             48 |  ||||| 39                                           0
-             |               | |  ||||| |                                            |
-             \---------------/ \  /|||| \------------------- CRID -------------------/
-                  VPeriod16     \/ ||||
-                                /  ||||
-           VPeri_Type <--------/   ||||
-                                   \/||
-           VP_Approx <-------------/ ||
-                                     \/
-           VPDir <-------------------/
-
-08~15 bytes: XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXXXX
-             127                              96 95                                 64
-             |                                 | |                                   |
-             \------------- Vehcl_Type --------/ \------------- VPeriod32 -----------/
-   @endverbatim
- *
- * @subsection subsec_1_2 field detail
- *
- * -# bit 0~39, 40 bits : CRID
- * -# bit 40~41, 2 bits : VPDir, indicate the restrict direction. The value range is [0, 3].\n
- *  - case value == 0 : Default value. The meaning is no direction.
- *  - case value == 1 : Restriction on the bidirections.
- *  - case value == 2 : Restriction on the order direction.
- *  - case value == 3 : Restriction on the reverse direction.
- * -# bit 42~43, 2 bits : VP_Approx, the value indacates the aproximation for VPeriod. The value ranges as [0, 2].
-    - case value == 0 : Not available.
-    - case value == 1 : Not the value approximated.
-    - case value == 2 : The value is approximated.
-    - case value == 3 : Not defined.
- * -# bit 44~47, 4 bits : VPeri_Type, value range [0,2].\n
- *  - case value == 0 : not available
- *  - case value == 1 : MMdd V.S. hhmm
- *  - case value == 2 : hhmm V.S. t1~t7
- *  - case other value: not defined
- * -# bit 48~95, 48 bits: VPeriod, the bit sequence rules the time of traffic regulation.
-    - case VPeri_Type == 1 :
-     - the part VPeriod16 : bit 48~63, 16 bits.
-      -# bit 48~51, 4 bits, start month. The value ranges [0, 12].
-       - case value == 0 : not available.
-       - case value == 1..12 : Jan .. Dec.
-       - case other value : not defined.
-      -# bit 52~55, 4 bits, end month. The value ranges [0, 12].
-       - case value == 0 : not available.
-       - case value == 1..12 : Jan .. Dec.
-       - case other value : not defined.
-      -# bit 56~63, 8 bits, not defined.
-     - the part VPeriod32 : bit 64~95, 32 bits.
-      -# bit 64~68, 5 bits, start date. The value ranges [0, 31].
-       - case value == 0 : not available.
-       - case value == 1..31 : The day in a month.
-      -# bit 69~73, 5 bits, end date. The value ranges [0, 31].
-       - case value == 0 : not available.
-       - case value == 1..31 : The day in a month.
-      -# bit 74~78, 5 bits, start hour. The value ranges [0, 23].
-       - case value == 0..23 : hour.
-       - case the other value : not available.
-      -# bit 79~83, 5 bits, end hour. The value ranges [0, 23].
-       - case value == 0..23 : hour.
-       - case the other value : not available.
-      -# bit 84~89, 6 bits, start miniute. The value ranges [0, 59].
-       - case value == 0..59 : minute.
-       - case the other value : not available.
-      -# bit 90~95, 6 bits, start miniute. The value ranges [0, 59].
-       - case value == 0..59 : minute.
-       - case the other value : not available.
-    - case VPeri_Type == 2 :
-     - the part VPeriod16 : bit 48~63, 16 bits. Not defined.
-     - the part VPeriod32 : bit 64~95, 32 bits.
-      -# bit 64~70, 7 bits, bit sequence. 
-       - bit 0..6 : Sun, Mon..Sat.
-      -# bit 71~73, 3 bits, not defined.
-      -# bit 74~78, 5 bits, start hour. The value ranges [0, 23].
-       - case value == 0..23 : hour.
-       - case the other value : not available.
-      -# bit 79~83, 5 bits, end hour. The value ranges [0, 23].
-       - case value == 0..23 : hour.
-       - case the other value : not available.
-      -# bit 84~89, 6 bits, start miniute. The value ranges [0, 59].
-       - case value == 0..59 : minute.
-       - case the other value : not available.
-      -# bit 90~95, 6 bits, start miniute. The value ranges [0, 59].
-       - case value == 0..59 : minute.
-       - case the other value : not available.
-
-    - case VPeri_Type == 3 :
-     - the part VPeriod16 : bit 48~63, 16 bits. Not defined.
-     - the part VPeriod32 : bit 64~95, 32 bits.
-      -# bit 64~73, 10 bits, not defined.
-      -# bit 74~78, 5 bits, start hour. The value ranges [0, 23].
-       - case value == 0..23 : hour.
-       - case the other value : not available.
-      -# bit 79~83, 5 bits, end hour. The value ranges [0, 23].
-       - case value == 0..23 : hour.
-       - case the other value : not available.
-      -# bit 84~89, 6 bits, start miniute. The value ranges [0, 59].
-       - case value == 0..59 : minute.
-       - case the other value : not available.
-      -# bit 90~95, 6 bits, start miniute. The value ranges [0, 59].
-       - case value == 0..59 : minute.
-       - case the other value : not available.
- * @section sec2 reach the Toll info
- * - The ETA info
- *   One toll ETA info is up to 8 bytes.
- *   The fields in one toll ETA info is like following.
- *  -# bit 00~39, 40 bits : condion ID.
- *  -# bit 40~43,  4 bits : toll type.
- *  -# bit 44~47,  4 bits : lane number.
- *  -# bit 48~63, 16 bits : not defined.
- * - The Pattern Info
- *   One toll pattern info is up to 16 bytes.
- *   The fields in one toll pattern info is like following.
- *  -# bit 00~39, 40 bits : condion ID.
- *  -# bit 40~63, 24 bits : not defined.
- *  -# bit 64~95, 32 bits : pattern number.
- *  -# bit 96~127, 32 bits : arrow nubmer.
- * @section sec3 reach the HW Junction info
- * @brief One HW Junction info is up to 24 bytes and has 3 parts. 
- *  The part 1 is 8 bytes. The part 2 is 6 bytes and the part 3 is 10 bytes.
- * @details the fields in these files are like following.
- * - part 1 : 8 bytes.
- *  -# bit 00~39, 40 bits : ID
- *  -# bit 40~47,  8 bits : not defined.
- *  -# bit 48~51,  4 bits : access type.
- *  -# bit 52~55,  4 bits : attribute.
- *  -# bit 56~63,  8 bits : estab item.
- *   - bit 56 : 1, restaurant. 0 , no restaurant available.
- *   - bit 57 : 1, shop. 0, no shop available.
- *   - bit 58 : 1, inn. 0, no inn available.
- *   - bit 59 : 1, public toilet. 0, no public toilet available.
- *   - bit 60~63 : Natural number, the gasoline station.
- *    - value == 21 : PetreChina.
- *    - value == 22 : sinopec
- *    - value == 23 : shell
- *    - value == 24 : Mobil
- *    - value == 25 : Brithish Petroleum
- *    - value == 26 : other
- * - part 2 : 6 bytes.
- *  bit 00~39, 40 bits : NodeID
- *  bit 40~63, 16 bits : not defined.
- * - part 3 : 10 bytes.
- *  -# byte 0~4 : inLinkID.
- *  -# byte 5~9 : outLinkID.
- */
-//-----------------------------------------------------------------------------
-//  Header Section
-//-----------------------------------------------------------------------------
-#include <fstream>
-#include <functional>
-#include <sstream>
-#include <array>
-#include <algorithm>
-#include <regex>
-#include <bitset>
-#include <type_traits>
-#include "cm_db.hpp"
-#include "cm_debug.h"
-
-//-----------------------------------------------------------------------------
-//  MACRO Defination
-//-----------------------------------------------------------------------------
-#define LOG_HEADER "[CM_DB]"
-
-#define TABLE_N            "N"
-#define TABLE_C            "C"
-#define TABLE_CR           "CR"
-#define TABLE_C_CR         "C_CR"
-#define TABLE_Toll_ETA     "Toll_ETA"
-#define TABLE_Toll_Pattern "Toll_Pattern"
-#define TABLE_HW_Junction  "HW_Junction"
-#define PROVINCE_PTN       R"((beijing|liaoning|tianjin))"
-#define MEM_DB             ":memory:"
-
-//-----------------------------------------------------------------------------
-//  Constants Defination
-//-----------------------------------------------------------------------------
-static const int VP_INVALID_HOUR = 24;
-static const int VP_INVALID_MINUTE = 60;
-
-//-----------------------------------------------------------------------------
-//  Type Defination
-//-----------------------------------------------------------------------------
-union UINT16_bytes
-{
-   uint16_t val;
-   char buf[sizeof(val)];
-};
-union UINT32_bytes
-{
-   uint32_t val;
-   char buf[sizeof(val)];
-};
-union UINT64_bytes
-{
-   uint64_t val;
-   char buf[sizeof(val)];
-};
-
-struct alignas(16) CR_RowData {
-   uint64_t CRID : 40;              /* 5 bytes */
-   uint32_t VPDir: 2;               /* 2/8 byte */
-   uint32_t VP_Approx : 2;          /* 2/8 byte */
-   uint32_t VPeri_Type : 4;         /* 4/8 byte */
-   uint16_t VPeriod16;              /* 2 bytes */
-   uint32_t VPeriod32;              /* 4 bytes */
-   uint32_t Vehcl_Type;             /* 4 bytes */
-} ;
-struct alignas(8) TollETA_RowData{
-   uint64_t CondID : 40;
-   uint32_t TollType : 4;
-   uint32_t lane_num : 4;
-};
-struct alignas(16) TollPattern_RowData{
-   uint64_t CondID : 40;            /* 5 bytes */
-   uint32_t : 24;                   /* 3 bytes : padding */
-   uint32_t PatterNo;               /* 4 bytes */
-   uint32_t ArrowNo;                /* 4 bytes */
-};
-//-----------------------------------------------------------------------------
-//  Local Varibles Declaration
-//-----------------------------------------------------------------------------
-static const auto g_bname_ptn = std::make_tuple(
-   std::regex("N" PROVINCE_PTN),
-   std::regex("C" PROVINCE_PTN),
-   std::regex("CR" PROVINCE_PTN),
-   std::regex("Toll_ETA" PROVINCE_PTN),
-   std::regex("Toll_Pattern" PROVINCE_PTN),
-   std::regex(PROVINCE_PTN "_C_CR_Toll"),
-   std::regex("HW_Junction")
-);
-
-static struct{
-   std::regex type1;
-   std::regex type2;
-   std::regex type3;
-   std::regex MonthDay;
-   std::regex WeekDay;
-   std::regex hour;
-   std::regex HourMinute;
-} g_VPeriadRegex = {
-   std::regex(R"(\[\((.+)\)\((.+)\)\]\*\[\((.+)\)\((.+)\)\])"),
-   std::regex("\\[\\((.+)\\)\\((.+)\\)\\]\\*\\((.+)\\)"),
-   std::regex(R"(\[\((.+)\)\((.+)\)\])"),
-   std::regex(R"(M(\d{1,2})d(\d{1,2}))"),
-   std::regex(R"((t\d){1,7})"),
-   std::regex(R"(h(\d{1,2}))"),
-   std::regex(R"(h(\d{1,2})m(\d{1,2}))")
-};
-static bool g_isPlatformLittleEndian = []{UINT32_bytes u; u.val = 0x87654321; 
-   return u.buf[0] < u.buf[1];}();
-//-----------------------------------------------------------------------------
-//  Local Utility
-//-----------------------------------------------------------------------------
-template<typename T>
-T _LE(T n)
-{
-   static_assert(std::is_integral<T>::value, "_LE");
-   if (  ! g_isPlatformLittleEndian ) {
-      union{
-         T val;
-         char buf[sizeof(val)];
-      }u;
-      u.val = n;
-      std::reverse(std::begin(u.buf), std::end(u.buf));
-   }
-   return n;
-}
-
-template<typename T>
-inline void _bzero(T& r)
-{
-   auto addr = reinterpret_cast<char*>(&r);
-   static_assert(std::is_pod<T>::value, "_bzero");
-   std::fill_n(addr, sizeof(r), '\0');
-}
-
-static std::vector<std::string> _strdiv(const std::string& s, char delim)
-{
-   std::vector<std::string> v;
-   std::string token;
-
-   std::string::size_type find_start = 0;
-   auto find_pos = s.find_first_of(delim, find_start);
-   while ( std::string::npos != find_pos )
-   {
-      auto find_size = find_pos - find_start;
-
-      token = s.substr(find_start, find_size);
-      if ( ! token.empty() ) 
-      {
-         v.push_back(std::move(token));
-      }
-
-      find_start = find_pos + 1;
-      find_pos = s.find_first_of(delim, find_start);
-   }
-
-   token = s.substr(find_start);
-   if ( ! token.empty() ) 
-   {
-      v.push_back(std::move(token));
-   }
-
-   return v;
-}
-
-uint32_t _stou32(const std::string s, int base = 10)
-{
-   static_assert(sizeof(int) == 4, "_stou32");
-   return static_cast<uint32_t>(stoi(s, 0, base));
-}
-
-uint64_t _stou64(const std::string s, int base = 10)
-{
-   static_assert(sizeof(long) == 8, "_stou64");
-   return static_cast<uint64_t>(stoul(s, 0, base));
-}
-
-static bool _strip_quotes(std::string& token)
-{
-   bool isQuoted = true;
-   char quote = '\"';
-
-   auto first = token.find_first_of(quote);
-   if(std::string::npos != first)
-   {
-      token.erase(0, first + 1);
-   }
-   else
-   {
-      isQuoted = false;
-   }
-
-   auto last = token.find_last_of(quote);
-   if (std::string::npos != last)
-   {
-      token.erase(last);
-   }
-   else
-   {
-      isQuoted = false;
-   }
-
-   return isQuoted;
-}
-
-static void _strfit8bytes(std::string& s)
-{
-   auto modsiz = 8;
-   auto modnum = s.size() % modsiz;
-   if (0 != modnum) 
-   {
-      auto padnum = modsiz - modnum;
-      s.append(padnum, '\0');
-   }
-
-}
-
-static CR_RowData _CR_row2data(
-   const std::string& txtCRID,
-   const std::string& txtVPeriod,
-   const std::string& txtVPDir,
-   const std::string& txtVeh_Type,
-   const std::string& txtVP_Appro
-)
-{
-   CR_RowData  buf;
-   auto& vp{g_VPeriadRegex}; 
-
-   static_assert(sizeof(buf) == 16, "buffer is not 16 bytes;");
-
-   //CM_LOG_INFO("%s CRID \"%s\".", LOG_HEADER, txtCRID.c_str());
-   buf.CRID = _LE(_stou64(txtCRID)); 
-   //CM_LOG_INFO("%s VPDir \"%s\".", LOG_HEADER, txtVPDir.c_str());
-   buf.VPDir = _LE(_stou32(txtVPDir)); 
-   //CM_LOG_INFO("%s VP_Approx \"%s\".", LOG_HEADER, txtVP_Appro.c_str());
-   if ( ! txtVP_Appro.empty() ) 
-   {
-      buf.VP_Approx = _LE(_stou32(txtVP_Appro) + 1);
-   }
-   else 
-   {
-      buf.VP_Approx = 0;
-   }
-
-   //CM_LOG_INFO("%s Veh_Type \"%s\".", LOG_HEADER, txtVeh_Type.c_str());
-   if ( ! txtVeh_Type.empty() ) 
-   {
-      auto type64 = _stou64(txtVeh_Type, 2);
-      buf.Vehcl_Type = _LE(static_cast<uint32_t>(type64));
-   }
-   else 
-   {
-      buf.Vehcl_Type = 0;
-   }
-
-   //CM_LOG_INFO("%s VPeriaod \"%s\".", LOG_HEADER, txtVPeriod.c_str());
-   if ( ! txtVPeriod.empty() ) 
-   {
-      std::smatch m;
-      if ( std::regex_match(txtVPeriod, m, vp.type1) ) 
-      {
-         //CM_LOG_INFO("%s type 1 %s.", LOG_HEADER, txtVPeriod.c_str());
-         if ( m.size() == 2 ) 
-         {
-            CM_LOG_INFO("%s %s , %s", LOG_HEADER, m[0].str().c_str(), m[1].str().c_str());
-         }
-         std::string Dt1, Dt2, t1, t2;
-         std::tie(Dt1, Dt2, t1, t2) = std::make_tuple(m[1].str(), m[2].str(), m[3].str(), m[4].str());
-
-         short int M1, M2;
-         M1 = M2 = 0;                  /* Month */
-
-         static_assert(sizeof(short int) == 2, "short type is not 2 bytes");
-
-         int d1, d2, h1, h2, m1, m2;
-         d1 = d2 = 0;                  /* the day in Month */
-         h1 = h2 = VP_INVALID_HOUR;
-         m1 = m2 = VP_INVALID_MINUTE;
-
-         if ( std::regex_match(Dt1, m, vp.MonthDay) ) 
-         {
-            M1 = stoi(m[1].str());
-            d1 = stoi(m[2].str());
-         }
-
-         if ( std::regex_match(Dt2, m, vp.MonthDay) ) 
-         {
-            M2 = stoi(m[1].str());
-            d2 = stoi(m[2].str());
-         }
-
-         if ( std::regex_match(t1, m, vp.HourMinute) ) 
-         {
-            h1 = stoi(m[1].str());
-            m1 = stoi(m[2].str());
-         }
-         else if ( std::regex_match(t1, m, vp.hour) ) 
-         {
-            h1 = stoi(m[1].str());
-         }
-
-         if ( std::regex_match(t2, m, vp.HourMinute) ) 
-         {
-            h2 = stoi(m[1].str());
-            m2 = stoi(m[2].str());
-         }
-         else if ( std::regex_match(t2, m, vp.hour) ) 
-         {
-            h2 = stoi(m[1].str());
-         }
-
-         uint16_t peri16 = 0;
-         peri16 |= M1;
-         peri16 |= M2 << 4;
-
-         uint32_t peri32 = 0;
-         peri32 |= d1;
-         peri32 |= d2 << 5;
-         peri32 |= h1 << 10;
-         peri32 |= h2 << 15;
-         peri32 |= m1 << 20;
-         peri32 |= m2 << 26;
-
-         //CM_LOG_INFO("%s (%d,%d)                 ==> 0x%04x", LOG_HEADER, M1, M2, peri16);
-         //CM_LOG_INFO("%s (%d,%d)-(%d,%d)-(%d,%d) ==> 0x%08x", LOG_HEADER, d1, d2, h1, m1, h2, m2, peri32);
-
-         buf.VPeri_Type = 1;
-         buf.VPeriod16  = _LE(peri16);
-         buf.VPeriod32  = _LE(peri32);
-      }
-      else if ( std::regex_match(txtVPeriod, m, vp.type2) ) 
-      {
-         //CM_LOG_INFO("%s type 2, size %d, %s.", LOG_HEADER, m.size(), txtVPeriod.c_str());
-         std::string t1, t2, weekday;
-         std::tie(t1, t2, weekday) = std::make_tuple(m[1].str(), m[2].str(), m[3].str());
-
-         int h1, h2, m1, m2;
-         h1 = h2 = VP_INVALID_HOUR;
-         m1 = m2 = VP_INVALID_MINUTE;
-
-         if ( std::regex_match(t1, m, vp.hour) ) 
-         {
-            h1 = stoi(m[1].str());
-         }
-         else if ( std::regex_match(t1, m, vp.HourMinute) ) 
-         {
-            h1 = stoi(m[1].str());
-            m1 = stoi(m[2].str());
-         }
-
-         if ( std::regex_match(t2, m, vp.hour) ) 
-         {
-            h2 = stoi(m[1].str());
-         }
-         else if ( std::regex_match(t2, m, vp.HourMinute) ) 
-         {
-            h2 = stoi(m[1].str());
-            m2 = stoi(m[2].str());
-         }
-
-         char wd = 0x00;
-         if ( std::regex_match(weekday, m, vp.WeekDay) ) 
-         {
-            for(auto i = 1; i < weekday.size(); i += 2 )
-            {
-               switch(weekday[i])
-               {
-                  case '1':
-                     wd |= 0x01;
-                     break;
-
-                  case '2':
-                     wd |= 0x02;
-                     break;
-
-                  case '3':
-                     wd |= 0x04;
-                     break;
-
-                  case '4':
-                     wd |= 0x08;
-                     break;
-
-                  case '5':
-                     wd |= 0x10;
-                     break;
-
-                  case '6':
-                     wd |= 0x20;
-                     break;
-
-                  case '7':
-                     wd |= 0x40;
-                     break;
-
-                  default:
-                     CM_LOG_INFO("%s unexpected %c.", LOG_HEADER, weekday[i]);
-               }
-            }
-         }
-
-         uint32_t peri32 = 0;
-         peri32 |= wd;
-         peri32 |= h1 << 10;
-         peri32 |= h2 << 15;
-         peri32 |= m1 << 20;
-         peri32 |= m2 << 26;
-
-         //CM_LOG_INFO("%s (%d,%d)-(%d,%d)-(0x%02x) ==> 0x%08x", LOG_HEADER, h1, m1, h2, m2, wd, peri32);
-
-         buf.VPeri_Type = 2;
-         buf.VPeriod16  = 0;
-         buf.VPeriod32  = _LE(peri32);
-      }
-      else if( std::regex_match(txtVPeriod, m, vp.type3) )
-      {
-         //CM_LOG_INFO("%s type 3 %s.", LOG_HEADER, txtVPeriod.c_str());
-         std::string t1, t2;
-         std::tie(t1, t2) = std::make_pair(m[1].str(), m[2].str());
-
-         int h1, h2, m1, m2;
-         h1 = h2 = VP_INVALID_HOUR;
-         m1 = m2 = VP_INVALID_MINUTE;
-
-         if ( std::regex_match(t1, m, vp.hour) ) 
-         {
-            h1 = stoi(m[1].str());
-         }
-         else if ( std::regex_match(t1, m, vp.HourMinute) ) 
-         {
-            h1 = stoi(m[1].str());
-            m1 = stoi(m[2].str());
-         }
-
-         if ( std::regex_match(t2, m, vp.hour) ) 
-         {
-            h2 = stoi(m[1].str());
-         }
-         else if ( std::regex_match(t2, m, vp.HourMinute) ) 
-         {
-            h2 = stoi(m[1].str());
-            m2 = stoi(m[2].str());
-         }
-
-         uint32_t peri32 = 0;
-         peri32 |= h1 << 10;
-         peri32 |= h2 << 15;
-         peri32 |= m1 << 20;
-         peri32 |= m2 << 26;
-
-         //CM_LOG_INFO("%s (%d,%d)-(%d,%d) ==> 0x%08x", LOG_HEADER, h1, m1, h2, m2, peri32);
-
-         buf.VPeri_Type = 3;
-         buf.VPeriod16  = 0;
-         buf.VPeriod32  = _LE(peri32);
-      }
-      else
-      {
-         CM_LOG_INFO("%s type 4 %s.", LOG_HEADER, txtVPeriod.c_str());
-      }
-   }
-   else 
-   {
-      buf.VPeri_Type = 0;
-   }
-   return buf;
-}
-
-std::pair<TollETA_RowData, std::string> _TollETA_row2data(
-      const std::string& txtCondID, 
-      const std::string& txtTollMode,
-      const std::string& txtTollCard,
-      const std::string& txtTollType
-)
-{
-   TollETA_RowData buf;
-   std::string extbuf;
-
-   static_assert(sizeof(buf) == 8, "buffer is not 8 bytes;");
-
-   buf.CondID = _LE(_stou64(txtCondID)); 
-   buf.TollType = _stou32(txtTollType);
-   char delim = '|';
-   std::string& TollMode = extbuf;
-   std::string& TollCard = extbuf;
-   if ( ! txtTollMode.empty() ) 
-   {
-      auto v = _strdiv(txtTollMode, delim);
-      for( auto & e : v)
-      {
-         TollMode.push_back(static_cast<char>(stoi(e, nullptr, 2)));
-      }
-   }
-
-   if ( ! txtTollCard.empty() ) 
-   {
-      auto v = _strdiv(txtTollCard, delim);
-      for( auto & e : v)
-      {
-         TollCard.push_back(static_cast<char>(stoi(e)));
-      }
-   }
-
-
-   if( ! TollMode.empty())
-   {
-      buf.lane_num = TollMode.size();
-      //CM_LOG_INFO("%s type %d, lane number %d", LOG_HEADER, buf.TollType, buf.lane_num);
-      _strfit8bytes(TollMode);
-   }
-   else if( ! TollCard.empty())
-   {
-      buf.lane_num = TollCard.size();
-      //CM_LOG_INFO("%s type %d, lane number %d", LOG_HEADER, buf.TollType, buf.lane_num);
-      _strfit8bytes(TollCard);
-   }
-   else
-   {
-      CM_LOG_WARNING("%s ETA record is something empty!", LOG_HEADER);
-   }
-
-   return std::make_pair(std::ref(buf), std::ref(extbuf));;
-}
-
-TollPattern_RowData _TollPattern_row2data(
-      const std::string& txtCondID,
-      const std::string& txtPaternNo,
-      const std::string& txtArrowNo 
-)
-{
-   TollPattern_RowData buf;
-
-   static_assert(sizeof(buf) == 16, "buffer is not 16 bytes;");
-
-   buf.CondID = _LE(_stou64(txtCondID)); 
-   auto ptnNo = txtPaternNo;
-   ptnNo.replace(0,1, "0x");
-   buf.PatterNo = _LE(_stou32(ptnNo, 16)); 
-   auto arrowNo = txtArrowNo;
-   arrowNo.replace(0, 1, "0x");
-   buf.ArrowNo = _LE(_stou32(arrowNo, 16)); 
-
-   return buf;
-}
-
-bool CCmDatabase::isLeadSameIcStr(const std::string& src, const std::string& dst, std::string::size_type n)
-{
-   auto m = std::min(dst.length(), src.length());
-   if ( std::string::npos == n ) 
-   {
-      n = m;
-   }
-   else
-   {
-      n = std::min(n, m);
-   }
-   
-   bool is_same = true;
-   for ( decltype(n) i = 0; i < n; ++i ) 
-   {
-      auto& a = src[i];
-      auto& b = dst[i];
-      if ( a != b ) 
-      {
-         if(std::isalpha(a, m_loc) && std::isalpha(b, m_loc))
-         {
-            if(std::tolower(a, m_loc) != std::tolower(b, m_loc))
-            {
-               is_same = false;
-               break;
-            }
-         }
-         else
-         {
-            is_same = false;
-            break;
-         }
-      }
-   }
-
-   //CM_LOG_INFO("%s %s , %s is %s", LOG_HEADER, src.c_str(), dst.c_str(), is_same ? "same": "not same");
-   return is_same;
-}
-void CCmDatabase::fit_to_graph(std::string& s)
-{
-   auto pred = [this](const char& c){return std::isgraph(c, this->m_loc);};
-   auto it = std::find_if(s.begin(), s.end(), pred);
-   if(s.end() != it)
-   {
-      ///< remove leading white space
-      std::string::size_type num = std::distance(s.begin(), std::next(it));
-      s.erase(0, num);
-   }
-
-   auto rit = std::find_if(s.rbegin(), s.rend(), pred);
-   if ( s.rend() != rit ) 
-   {
-      ///< erase ending white space
-      std::string::size_type num = std::distance(s.rbegin(), std::next(rit));
-      auto pos = s.size() - num;
-      s.erase(pos);
-   }
-}
-
-std::tuple<std::string, std::string, std::string> CCmDatabase::parse_path(const std::string& path)
-{
-   std::string dir, basename, ext;
-   std::string filename = path;
-
-   auto pos  = path.find_last_of('/');
-   if ( std::string::npos != pos ) 
-   {
-      dir = path.substr(0, pos);
-      filename = path.substr(pos + 1);
-   }
-
-   basename = filename;
-   pos = filename.find_last_of('.');
-   if ( std::string::npos != pos ) 
-   {
-      ext = filename.substr(pos + 1);
-      basename = filename.substr(0, pos);
-   }
-
-   return std::make_tuple(std::ref(dir), std::ref(basename), std::ref(ext));
-}
-//-----------------------------------------------------------------------------
-//  Implement Section For class CCmDatabase
-//-----------------------------------------------------------------------------
-CCmDatabase::CCmDatabase()
-: m_db(nullptr)
-, m_loc("")
-, m_stmtSelectCR(nullptr)
-, m_stmtSelectTollETA(nullptr)
-, m_stmtSelectTollPatern(nullptr)
-, m_stmtSelectHWJunction(nullptr)
-{
-}
-
-CCmDatabase::~CCmDatabase()
-{
-   if ( m_db ) 
-   {
-      delete m_db;
-   }
-}
-
-/*!
- *  \brief  import "*.mid" files
- * \param path the mid file path.\n
- * The mid file base name should be leading by Toll_ETA, Toll_Patern
- * \return import OK or not 
- * \retval true import OK
- * \retval false import failed
- *
- */
-bool CCmDatabase::import_mid(const char* path)
-{
-   bool ok = true;
-
-   if ( path ) 
-   {
-      std::string dir, basename, ext;
-      auto result = parse_path(std::string(path));
-      std::tie(dir, basename, ext) = result;
-
-      CM_LOG_INFO("%s dir \"%s\", basename \"%s\", ext \"%s\".", LOG_HEADER, dir.c_str(), basename.c_str(), ext.c_str());
-      if ( ! basename.empty() && ext == "mid") 
-      {
-         bool is_opened = open_db(MEM_DB);
-         if ( is_opened ) 
-         {
-            std::regex ptn_N, ptn_C, ptn_CR, ptn_ETA, ptn_Pattern, ptn_C_CR_Toll, ptn_Junction;
-            std::tie(ptn_N, ptn_C, ptn_CR, ptn_ETA, ptn_Pattern, ptn_C_CR_Toll, ptn_Junction) = g_bname_ptn;
-            if( std::regex_match(basename, ptn_N))
-            {
-               is_opened = open_mid_N(path);
-            }
-            else if( std::regex_match(basename, ptn_C))
-            {
-               is_opened = open_mid_C(path);
-            }
-            else if( std::regex_match(basename, ptn_CR))
-            {
-               is_opened = open_mid_CR(path);
-            }
-            else if( std::regex_match(basename, ptn_ETA))
-            {
-               is_opened = open_mid_Toll_ETA(path);
-            }
-            else if( std::regex_match(basename, ptn_Pattern))
-            {
-               is_opened = open_mid_Toll_Pattern(path);
-            }
-            else if( std::regex_match(basename, ptn_Junction))
-            {
-               is_opened = open_mid_HW_Junction(path);
-            }
-            else
-            {
-               CM_LOG_WARNING("%s the \"%s\" don't match any targets!", LOG_HEADER, basename.c_str());
-               is_opened = false;
-            }
-         }
-
-         if(is_opened)
-         {
-            std::string db_path = basename + '.' + "db";
-            if( ! dir.empty())
-            {
-               db_path = dir + '/' + db_path;
-            }
-            ok = save_as(db_path.c_str());
-            if(!ok)
-            {
-               CM_LOG_WARNING("%s save as \"%s\" failed!", LOG_HEADER, db_path.c_str());
-            }
-         }
-      }
-      else
-      {
-         CM_LOG_WARNING("%s inpute path is not illegal : basename \"%s\", ext \"%s\".", LOG_HEADER, basename.c_str(), ext.c_str());
-      }
-   }
-   else 
-   {
-      CM_LOG_ERROR("%s the input path is NULL!", LOG_HEADER);
-      ok = false;
-   }
-
-   return ok;
-}
-
-bool CCmDatabase::open_mid(const char* path, const size_t fldnum, const char* sqlins)
-{
-   bool ok = true;
-
-   if ( nullptr != path && nullptr != sqlins && fldnum > 0) 
-   {
-      CM_LOG_INFO("%s open \"%s\", field number : %d, insert SQL is \"%s\".", LOG_HEADER, path, fldnum, sqlins);
-      auto stmt = m_db->create_statement(sqlins);
-      if (stmt)
-      {
-         std::ifstream mid(path);
-         if (mid.is_open())
-         {
-            size_t lineno = 0;
-            std::string linebuf;
-            std::string field[fldnum];
-
-            while (getline(mid, linebuf))
-            {
-               size_t tkn_num = 0;
-               std::string token;
-               std::istringstream is(linebuf);
-               while (std::getline(is, token, ','))
-               {
-
-                  size_t fld_idx = tkn_num++;
-                  if (fld_idx < fldnum)
-                  {
-                     _strip_quotes(token);
-                     // NOTE : the the fields to bind have to be the same life cycle with the statement step.
-                     field[fld_idx] = std::move(token);
-                     stmt->bind_text(tkn_num, field[fld_idx].c_str());
-                  }
-                  else
-                  {
-                     CM_LOG_WARNING("%s field number(%d) exceeded!", LOG_HEADER, tkn_num);
-                     break;
-                  }
-               }
-            
-               if ( tkn_num > 0 ) 
-               {
-                  stmt->step();
-                  stmt->reset();
-               }
-
-               decltype(lineno) print_step = 1000;
-               if ( 0 == lineno++ % print_step ) 
-               {
-                  CM_LOG_INFO("%s ====> line NO:%d", LOG_HEADER, lineno);
-               }
-            }
-            CM_LOG_INFO("%s ====>last line NO:%d", LOG_HEADER, ++lineno);
-         }
-         else
-         {
-            CM_LOG_ERROR("%s open %s failed!", LOG_HEADER, path);
-            ok = false;
-         }
-      }
-
-   }
-   else 
-   {
-      CM_LOG_ERROR("%s Illegal parameters : open path is %p, field number is %d, insert SQL is %d." LOG_HEADER, path, fldnum, sqlins);
-   }
-   return ok;
-}
-
-bool CCmDatabase::open_mid_N(const char* path)
-{
-   static const size_t FIELD_NUM = 13;
-   std::string sql = "create table if not exists " 
-      TABLE_N
-      "("
-         "MapID text not null,"
-         "ID text not null,"
-         "Kind_num text not null,"
-         "Kind text not null,"
-         "Cross_flag text not null,"
-         "Light_flag text not null,"
-         "Cross_LID text not null,"
-         "mainNodeID text not null,"
-         "subNodeID text not null,"
-         "subNodeID2 text not null,"
-         "Adjoin_MID text not null,"
-         "Adjoin_NID text not null,"
-         "Node_LID text not null"
-      ");";
-
-   bool ok = m_db->execute( sql.c_str() );
-   if (ok)
-   {
-      sql = "insert into " TABLE_N " values(?,?,?,?,?,?,?,?,?,?,?,?,?)";
-      ok = open_mid(path, FIELD_NUM, sql.c_str());
-   }
-   else
-   {
-      CM_LOG_ERROR("%s create table failed!", LOG_HEADER);
-   }
-
-   return ok;
-}
-
-bool CCmDatabase::open_mid_C(const char* path)
-{
-   static const size_t FIELD_NUM = 10;
-   std::string sql = "create table if not exists " 
-      TABLE_C
-      "("
-         "MapID text not null,"
-         "CondID text not null,"
-         "ID text not null,"
-         "inLinkId text not null,"
-         "outLinkId text not null,"
-         "CondType text not null,"
-         "CRID text not null,"
-         "Passage text not null,"
-         "Slope text not null,"
-         "SGNL_LOCTION text not null"
-      ");";
-
-   bool ok = m_db->execute( sql.c_str() );
-   if (ok)
-   {
-      sql = "insert into " TABLE_C " values(?,?,?,?,?,?,?,?,?,?)";
-      ok = open_mid(path, FIELD_NUM, sql.c_str());
-   }
-   else
-   {
-      CM_LOG_ERROR("%s create table failed!", LOG_HEADER);
-   }
-
-   return ok;
-}
-
-bool CCmDatabase::open_mid_CR(const char* path)
-{
-   static const size_t FIELD_NUM = 5;
-   std::string sql = "create table if not exists " 
-      TABLE_CR
-      "("
-         "CRID text not null,"               // CRID field is not set as primary key, because is could be multiple
-         "VPeriod text not null,"
-         "VPDir text not null,"
-         "Vehcl_Type text not null,"
-         "VP_Approx text not null"
-      ");";
-
-   bool ok = m_db->execute( sql.c_str() );
-   if (ok)
-   {
-      sql = "insert into " TABLE_CR " values(?,?,?,?,?)";
-      ok = open_mid(path, FIELD_NUM, sql.c_str());
-   }
-   else
-   {
-      CM_LOG_ERROR("%s create table failed!", LOG_HEADER);
-   }
-
-   return ok;
-}
-
-bool CCmDatabase::open_mid_Toll_ETA(const char* path)
-{
-   static const size_t FIELD_NUM = 4;
-   std::string sql = "create table if not exists " 
-      TABLE_Toll_ETA
-      "("
-         "CondId text not null primary key,"
-         "TollMode text not null,"
-         "CardMode text not null,"
-         "TollType text not null"
-      ");"; 
-
-   bool ok = m_db->execute( sql.c_str() );
-   if (ok)
-   {
-      sql = "insert into " TABLE_Toll_ETA " values(?,?,?,?)";
-      ok = open_mid(path, FIELD_NUM, sql.c_str());
-   }
-   else
-   {
-      CM_LOG_ERROR("%s Toll_ETA path is NULL!", LOG_HEADER);
-   }
-
-   return ok;
-}
-
-bool CCmDatabase::open_mid_Toll_Pattern(const char* path)
-{
-   static const size_t FIELD_NUM = 3;
-   std::string sql = "create table if not exists " 
-      TABLE_Toll_Pattern
-      "("
-         "CondId text not null primary key,"
-         "Pattern text not null,"
-         "ArrowNo text not null"
-      ");";
-
-   bool ok = m_db->execute( sql.c_str() );
-   if (ok)
-   {
-      sql = "insert into " TABLE_Toll_Pattern " values(?,?,?)";
-      ok = open_mid(path, FIELD_NUM, sql.c_str());
-   }
-   else
-   {
-      CM_LOG_ERROR("%s Toll_Pattern path is NULL!", LOG_HEADER);
-   }
-
-   return ok;
-}
-
-bool CCmDatabase::open_mid_HW_Junction(const char* path)
-{   
-   static const size_t FIELD_NUM = 11;
-   std::string sql = "create table if not exists "
-      TABLE_HW_Junction
-      "("
-         "MapID text not null,"              /* #1 */
-         "ID text not null,"
-         "NodeID text not null,"
-         "inLinkID text not null,"
-         "outLinkID text not null,"
-         "AccessType text not null,"         /* #6 */
-         "Attr text not null,"
-         "Dis_Betw text not null,"
-         "Seq_Nm text not null,"
-         "HW_PID text not null,"
-         "Estab_Item text not null"          /* #11 */
-      ");";
-
-   bool ok = m_db->execute(sql.c_str());
-   if (ok)
-   {
-      sql = "insert into " TABLE_HW_Junction " values(?,?,?,?,?,?,?,?,?,?,?)";
-      ok = open_mid(path, FIELD_NUM, sql.c_str());
-   }
-   else
-   {
-      CM_LOG_ERROR("%s create table \"%s\" failed!" LOG_HEADER, sql.c_str());
-   }
-
-   return ok;
-
-}
-
-bool CCmDatabase::save_as(const char* path)
-{
-   return m_db->backup(path);
-}
-
-bool CCmDatabase::open_db(const char* path)
-{
-   bool ok = false;
-   if (path && nullptr == m_db)
-   {
-      m_db = new CCmSqlite(path);
-      ok = true;
-   }
-   else
-   {
-      CM_LOG_ERROR("%s DB path : \"%s\", DB pointer %p!", LOG_HEADER, path, m_db);
-   }
-
-   return ok;
-}
-
-bool CCmDatabase::parse_db(const char* path)
-{
-   bool ok = true;
-
-   if ( path ) 
-   {
-      std::string dir, basename, ext;
-      std::tie(dir, basename, ext) = parse_path(std::string(path));
-
-      CM_LOG_INFO("%s dir \"%s\", basename \"%s\", ext \"%s\".", LOG_HEADER, dir.c_str(), basename.c_str(), ext.c_str());
-      if ( ! basename.empty() && ext == "db") 
-      {
-         auto bin_path = [&](){
-            std::string bp = basename + '.' + "bin";
-            if( ! dir.empty())
-            {
-               bp = dir + '/' + bp;
-            }
-            return bp;
-         };
-
-         std::regex ptn_N, ptn_C, ptn_CR, ptn_ETA, ptn_Pattern, ptn_C_CR_Toll, ptn_Junction;
-         std::tie(ptn_N, ptn_C, ptn_CR, ptn_ETA, ptn_Pattern, ptn_C_CR_Toll, ptn_Junction) = g_bname_ptn;
-
-         bool is_opened = false;
-         if( std::regex_match(basename, ptn_CR))
-         {
-            is_opened = open_db(path);
-            if ( is_opened ) 
-            {
-               ok = parse_db_CR(bin_path().c_str());
-            }
-         }
-         else if( std::regex_match(basename, ptn_ETA))
-         {
-            is_opened = open_db(path);
-            if ( is_opened ) 
-            {
-               ok = parse_db_Toll_ETA(bin_path().c_str());
-            }
-         }
-         else if( std::regex_match(basename, ptn_Pattern))
-         {
-            is_opened = open_db(path);
-            if ( is_opened ) 
-            {
-               ok = parse_db_Toll_Pattern(bin_path().c_str());
-            }
-         }
-         else if( std::regex_match(basename, ptn_C_CR_Toll))
-         {
-            is_opened = open_db(path);
-            if ( is_opened ) 
-            {
-               ok = parse_db_C_CR_Toll(bin_path().c_str());
-            }
-         }
-         else if( std::regex_match(basename, ptn_Junction))
-         {
-            is_opened = open_db(path);
-            if ( is_opened ) 
-            {
-               ok = parse_db_HW_Junction(bin_path().c_str());
-            }
-         }
-         else
-         {
-            CM_LOG_WARNING("%s the \"%s\" don't match any targets!", LOG_HEADER, basename.c_str());
-            is_opened = false;
-         }
-
-      }
-      else
-      {
-         CM_LOG_WARNING("%s inpute path is not illegal : basename \"%s\", ext \"%s\".", LOG_HEADER, basename.c_str(), ext.c_str());
-      }
-   }
-   else 
-   {
-      CM_LOG_ERROR("%s the input path is NULL!", LOG_HEADER);
-      ok = false;
-   }
-
-   return ok;
-}
-
-bool CCmDatabase::parse_db_CR(const char* bin_path)
-{
-   bool ok = false;
-
-   if ( nullptr == m_stmtSelectTollETA ) 
-   {
-      std::string sql = "select * from " TABLE_CR ";";
-      m_stmtSelectCR = m_db->create_statement(sql.c_str());
-   }
-
-   if ( nullptr != m_stmtSelectCR && nullptr != bin_path ) 
-   {
-      std::ofstream ofs(bin_path);
-      if ( ofs.is_open() ) 
-      {
-         CM_LOG_INFO("%s %s open OK.", LOG_HEADER, bin_path);
-
-         auto& vp    = g_VPeriadRegex; 
-         auto& sel   = m_stmtSelectCR;
-
-         while(sel->step_row())
-         {
-            size_t fld_pos = 0;
-            std::string txtCRID     = sel->get_text(fld_pos++);
-            std::string txtVPeriod  = sel->get_text(fld_pos++);
-            std::string txtVPDir    = sel->get_text(fld_pos++);
-            std::string txtVeh_Type = sel->get_text(fld_pos++);
-            std::string txtVP_Appro = sel->get_text(fld_pos++);
-
-            auto buf = _CR_row2data(txtCRID, txtVPeriod, txtVPDir, txtVeh_Type, txtVP_Appro);
-            ofs.write(reinterpret_cast<const char*>(&buf), sizeof(buf));
-         }
-
-         sel->reset();
-         ok = true;
-      }
-   }
-
-   return ok;
-}
-
-bool CCmDatabase::parse_db_Toll_ETA(const char* bin_path)
-{
-   bool ok = false;
-
-   if ( nullptr == m_stmtSelectTollETA ) 
-   {
-      std::string sql = "select * from " TABLE_Toll_ETA ";";
-      m_stmtSelectTollETA = m_db->create_statement(sql.c_str());
-   }
-
-   if ( nullptr != m_stmtSelectTollETA && nullptr != bin_path ) 
-   {
-      std::ofstream ofs(bin_path);
-      if ( ofs.is_open() ) 
-      {
-         CM_LOG_INFO("%s %s open OK.", LOG_HEADER, bin_path);
-         auto& sel = m_stmtSelectTollETA;
-         while(sel->step_row())
-         {
-            size_t fld_pos = 0;
-            std::string txtCondID   = sel->get_text(fld_pos++);
-            std::string txtTollMode = sel->get_text(fld_pos++);
-            std::string txtTollCard = sel->get_text(fld_pos++);
-            std::string txtTollType = sel->get_text(fld_pos++);
-
-            TollETA_RowData buf;
-            std::string extbuf;
-            std::tie(buf, extbuf) = _TollETA_row2data(txtCondID, txtTollMode, txtTollCard, txtTollType);
-
-            ofs.write(reinterpret_cast<const char*>(&buf), sizeof(buf));
-            ofs.write(extbuf.data(), extbuf.size());
-         }
-
-         sel->reset();
-         ok = true;
-      }
-   }
-
-   return ok;
-}
-
-bool CCmDatabase::parse_db_Toll_Pattern(const char* bin_path)
-{
-   bool ok = false;
-
-   if ( nullptr == m_stmtSelectTollPatern ) 
-   {
-      std::string sql = "select * from " TABLE_Toll_Pattern ";";
-      m_stmtSelectTollPatern = m_db->create_statement(sql.c_str());
-   }
-
-   if ( nullptr != m_stmtSelectTollPatern && nullptr != bin_path ) 
-   {
-      std::ofstream ofs(bin_path);
-      if ( ofs.is_open() ) 
-      {
-         CM_LOG_INFO("%s %s open OK.", LOG_HEADER, bin_path);
-         auto& sel = m_stmtSelectTollPatern;
-         while(sel->step_row())
-         {
-            size_t fld_pos = 0;
-            std::string txtCondID   = sel->get_text(fld_pos++);
-            std::string txtPaternNo = sel->get_text(fld_pos++);
-            std::string txtArrowNo  = sel->get_text(fld_pos++);
-
-            auto buf = _TollPattern_row2data(txtCondID, txtPaternNo, txtArrowNo);
-
-            ofs.write(reinterpret_cast<const char*>(&buf), sizeof(buf));
-         }
-
-         ok = true;
-         sel->reset();
-      }
-
-   }
-   return ok;
-}
-
-/*!
- *  \brief  parse DB file for HighWay Junction
- */
-bool CCmDatabase::parse_db_HW_Junction(const char* bin_path)
-{
-   bool ok = false;
-
-   if ( nullptr == m_stmtSelectHWJunction ) 
-   {
-      std::string sql = "select * from " TABLE_HW_Junction ";";
-      m_stmtSelectHWJunction = m_db->create_statement(sql.c_str());
-   }
-
-   if ( nullptr != m_stmtSelectHWJunction && nullptr != bin_path ) 
-   {
-      std::ofstream ofs(bin_path);
-      if ( ofs.is_open() ) 
-      {
-         CM_LOG_INFO("%s %s open OK.", LOG_HEADER, bin_path);
-         auto& sel = m_stmtSelectHWJunction;
-         while(sel->step_row())
-         {
-            size_t fld_pos = 0;
-            std::string txtMapID       = sel->get_text(fld_pos++);
-            std::string txtID          = sel->get_text(fld_pos++);
-            std::string txtNodeID      = sel->get_text(fld_pos++);
-            std::string txtinLinkID    = sel->get_text(fld_pos++);
-            std::string txtoutLinkID   = sel->get_text(fld_pos++);
-            std::string txtAccessType  = sel->get_text(fld_pos++);
-            std::string txtAttr        = sel->get_text(fld_pos++);
-            std::string txtDis_Betw    = sel->get_text(fld_pos++);
-            std::string txtSeq_Nm      = sel->get_text(fld_pos++);
-            std::string txtHW_PID      = sel->get_text(fld_pos++);
-            std::string txtEst_Item    = sel->get_text(fld_pos++);
-
-            struct{
-               uint64_t ID : 40;                /* 5 bytes */
-               uint32_t : 8;                    /* 1 byte : padding */
-               int32_t AccessType : 4;          /* 0.5 byte */
-               int32_t Attr : 4;                /* 0.5 byte */
-               uint32_t Estab_item : 8;         /* 1 byte */
-            }buf1;
-
-            static_assert(sizeof(buf1) == 8, "buffer is not 8 bytes;");
-
-            buf1.ID = _LE(_stou64(txtID)); 
-            buf1.AccessType = _LE(_stou32(txtAccessType)); 
-            buf1.Attr = _LE(_stou32(txtAttr)); 
-            buf1.Estab_item = 0;
-            char delim = '|';
-            if ( ! txtEst_Item.empty() ) 
-            {
-               unsigned char b = 0;
-               unsigned char gaso = 0;
-               auto v = _strdiv(txtEst_Item, delim);
-               for( auto & e : v)
-               {
-                  auto item = stoi(e);
-                  switch(item)
-                  {
-                     case 1:
-                     b |= 0x01;                 /* restaurant */
-                     break;
-
-                     case 2:
-                     b |= 0x02;                 /* shop */
-                     break;
-
-                     case 3:
-                     b |= 0x04;                 /* inn */
-                     break;
-
-                     case 4:
-                     b |= 0x08;                 /* pub toilet */
-                     break;
-
-                     case 21:
-                     gaso = 1;                  /* PetreChina */
-                     break;
-
-                     case 22:
-                     gaso = 2;                  /* sinopec */
-                     break;
-
-                     case 23:
-                     gaso = 3;                  /* shell */
-                     break;
-
-                     case 24:
-                     gaso = 4;                  /* Mobil */
-                     break;
-
-                     case 25:
-                     gaso = 5;                  /* British Petroleum */
-                     break;
-
-                     case 26:
-                     gaso = 0x0f;               /* Other */
-                     break;
-
-                     default:
-                     CM_LOG_WARNING("%s not expect the Estab_item %d", LOG_HEADER, item);
-                  }
-               }
-
-               if ( b ) 
-               {
-                  buf1.Estab_item |= b;
-               }
-               if ( gaso ) 
-               {
-                  buf1.Estab_item |= gaso << 4;
-               }
-            }
-
-            ofs.write(reinterpret_cast<const char*>(&buf1), sizeof(buf1));
-
-            struct{
-               uint64_t NodeID : 40;
-               char inLinkID[3];
-            } buf2;
-
-            buf2.NodeID = _LE(_stou64(txtNodeID));
-
-            union {
-               uint64_t inLinkID;
-               char buf[sizeof(inLinkID)];
-            } u;
-   
-            static_assert(sizeof(buf2) == 8, "buf2 is not 8 bytes!");
-            u.inLinkID = _LE(_stou64(txtinLinkID));
-            std::copy_n(u.buf, 3, buf2.inLinkID);
-
-            ofs.write(reinterpret_cast<const char*>(&buf2), sizeof(buf2));
-
-            struct{
-               char inLinkID[2];
-               uint64_t outLinkID : 40;
-            } buf3;
-
-            static_assert(sizeof(buf3) == 8, "buf3 is not 8 bytes!");
-            std::copy_n(u.buf + 3, 2, buf3.inLinkID);
-            buf3.outLinkID = _LE(_stou64(txtoutLinkID));
-
-            ofs.write(reinterpret_cast<const char*>(&buf3), sizeof(buf3));
-         }
-
-         ok = true;
-         sel->reset();
-      }
-   }
-
-   return ok;
-}
-
-std::string CCmDatabase::parse_db_C_CR_Toll()
-{
-   std::string bin;
-   std::string sql = R"(select * from C where CondID != "" or CRID != "";)";
-   auto stmt_sel_C = m_db->create_statement(sql.c_str());
-   if ( stmt_sel_C ) 
-   {
-      uint32_t row_num = 0;
-      std::ostringstream os;
-
-      decltype(stmt_sel_C) stmt_sel_CR, stmt_sel_TollETA, stmt_sel_TollPattern;
-      stmt_sel_CR = stmt_sel_TollETA = stmt_sel_TollPattern = nullptr;
-      while(stmt_sel_C->step_row())
-      {
-         size_t fld_pos = 0;
-         std::string txtMapID          = stmt_sel_C->get_text(fld_pos++);
-         std::string txtCondId         = stmt_sel_C->get_text(fld_pos++);
-         std::string txtID             = stmt_sel_C->get_text(fld_pos++);
-         std::string txtInLinkId       = stmt_sel_C->get_text(fld_pos++);
-         std::string txtOutLinkId      = stmt_sel_C->get_text(fld_pos++);
-         std::string txtCondType       = stmt_sel_C->get_text(fld_pos++);
-         std::string txtCRID           = stmt_sel_C->get_text(fld_pos++);
-         std::string txtPassage        = stmt_sel_C->get_text(fld_pos++);
-         std::string txtSlope          = stmt_sel_C->get_text(fld_pos++);
-         std::string txtSGNL_LOCTION   = stmt_sel_C->get_text(fld_pos++);
-
-         struct alignas(16) {
-            uint64_t InLinkId : 40;             /* 5 bytes */
-            char     OutLinkId [5];             /* 5 bytes */
-            uint8_t  CondType : 4;              // half byte
-            uint32_t cnt_CRID : 4;              // half byte
-            uint8_t  ETA_flag : 1;              /* 1/8 byte */
-            uint8_t  ptn_flag : 1;              /* 1/8 byte */
-         }rec_header;
-
-         static_assert(sizeof(rec_header) == 16, "The buffer for C table is not 16 bytes;");
-
-         _bzero(rec_header);
-         //CM_LOG_INFO("%s[C] CondType %s.", LOG_HEADER, txtCondType.c_str());
-         // condition type
-         rec_header.CondType = _LE(_stou32(txtCondType) - 1);
-         //CM_LOG_INFO("%s[C] inlink ID %s.", LOG_HEADER, txtInLinkId.c_str());
-         // inlink ID
-         if ( ! txtInLinkId.empty() ) {
-            rec_header.InLinkId = _LE(_stou64(txtInLinkId));
-         }
-         else {
-            rec_header.InLinkId = 0;
-         }
-         // outlink ID
-         if ( ! txtOutLinkId.empty() ) {
-            UINT64_bytes OutLinkId;
-            {
-               //CM_LOG_INFO("%s[C] outlink ID %s.", LOG_HEADER, txtOutLinkId.c_str());
-               OutLinkId.val = _LE(_stou64(txtOutLinkId));
-               std::copy_n(OutLinkId.buf, sizeof(rec_header.OutLinkId), rec_header.OutLinkId);
-            }
-         }
-         else {
-            std::fill(std::begin(rec_header.OutLinkId), std::end(rec_header.OutLinkId), 0); 
-         }
-
-         const size_t max_uint4bits = 15;
-
-         // CRID
-         rec_header.cnt_CRID = 0;
-
-         struct alignas(16){
-            uint32_t VPDir: 2;               /* 2/8 byte */
-            uint32_t VP_Approx : 2;          /* 2/8 byte */
-            uint32_t VPeri_Type : 4;         /* 4/8 byte */
-            uint8_t  reserved[5];      // 5 bytes
-            uint16_t VPeriod16;              /* 2 bytes */
-            uint32_t VPeriod32;              /* 4 bytes */
-            uint32_t Vehcl_Type;             /* 4 bytes */
-         } buf_CR;
-         
-         static_assert(sizeof(buf_CR) == 16, "buffer CR is not 16 bytes");
-
-         _bzero(buf_CR);
-         std::vector<decltype(buf_CR)> vec_CR;
-         if( ! txtCRID.empty())
-         {
-            // statment create/reset
-            if ( stmt_sel_CR ) 
-            {
-               stmt_sel_CR->reset();
-            }
-            else
-            {
-               sql = "select * from " TABLE_CR " where CRID == ?;";
-               stmt_sel_CR = m_db->create_statement(sql.c_str());
-            }
-
-            // loop the statement
-            if ( stmt_sel_CR ) 
-            {
-               stmt_sel_CR->bind_text(1, txtCRID.c_str());
-               while(stmt_sel_CR->step_row())
-               {
-                  size_t fld_pos = 0;
-                  std::string txtCRID     = stmt_sel_CR->get_text(fld_pos++);
-                  std::string txtVPeriod  = stmt_sel_CR->get_text(fld_pos++);
-                  std::string txtVPDir    = stmt_sel_CR->get_text(fld_pos++);
-                  std::string txtVeh_Type = stmt_sel_CR->get_text(fld_pos++);
-                  std::string txtVP_Appro = stmt_sel_CR->get_text(fld_pos++);
-
-                  auto row_buf = _CR_row2data(txtCRID, txtVPeriod, txtVPDir, txtVeh_Type, txtVP_Appro);
-
-                  _bzero(buf_CR);
-                  buf_CR.VPDir      = row_buf.VPDir;
-                  buf_CR.VP_Approx  = row_buf.VP_Approx;
-                  buf_CR.VPeri_Type = row_buf.VPeri_Type;
-                  buf_CR.VPeriod16  = row_buf.VPeriod16;
-                  buf_CR.VPeriod32  = row_buf.VPeriod32;
-                  buf_CR.Vehcl_Type = row_buf.Vehcl_Type;
-
-                  vec_CR.push_back(std::move(buf_CR));
-               }
-
-               rec_header.cnt_CRID = std::min(vec_CR.size(), max_uint4bits);
-               if ( rec_header.cnt_CRID > 1 )
-               {
-                  CM_LOG_INFO("%s CRID %s, cnt %d. ", LOG_HEADER, txtCRID.c_str(), rec_header.cnt_CRID);
-               }
-            }
-         }
-
-         rec_header.ETA_flag = 0;
-         rec_header.ptn_flag = 0;
-
-         struct alignas(16){
-            uint32_t ETA_type : 4;           /* half byte */
-            uint32_t lane_num : 4;           /* half byte */
-            char     laneinfo[15];           /* 15 bytes */
-         } buf_TollETA;
-
-         static_assert(sizeof(buf_TollETA) == 16, "The buffer for toll table is not 16 bytes;");
-
-         struct alignas(16){
-            uint32_t PatterNo;               /* 4 bytes */
-            uint32_t ArrowNo;                /* 4 bytes */
-         } buf_TollPattern;
-
-         static_assert(sizeof(buf_TollPattern) == 16, "The buffer for toll table is not 16 bytes;");
-
-         _bzero(buf_TollETA);
-         _bzero(buf_TollPattern);
-
-         if ( !txtCondId.empty() ) 
-         {
-            // Toll ETA : statment create/reset
-            if ( stmt_sel_TollETA ) 
-            {
-               stmt_sel_TollETA->reset();
-            }
-            else
-            {
-               sql = "select * from " TABLE_Toll_ETA " where CondID == ?;";
-               stmt_sel_TollETA = m_db->create_statement(sql.c_str());
-            }
-
-            if(stmt_sel_TollETA)
-            {
-               stmt_sel_TollETA->bind_text(1, txtCondId.c_str());
-
-               TollETA_RowData buf;
-               std::string lane;
-               size_t eta_cnt = 0;
-               while ( stmt_sel_TollETA->step_row() ) 
-               {
-                  size_t fld_pos = 0;
-                  std::string txtCondID_1 = stmt_sel_TollETA->get_text(fld_pos++);
-                  std::string txtTollMode = stmt_sel_TollETA->get_text(fld_pos++);
-                  std::string txtTollCard = stmt_sel_TollETA->get_text(fld_pos++);
-                  std::string txtTollType = stmt_sel_TollETA->get_text(fld_pos++);
-
-                  std::tie(buf, lane) = _TollETA_row2data(txtCondID_1, txtTollMode, txtTollCard, txtTollType);;
-                  eta_cnt++;
-               }
-
-               if ( eta_cnt == 1 && lane.size() <= sizeof(buf_TollETA.laneinfo)) {
-                  buf_TollETA.ETA_type = buf.TollType;
-                  buf_TollETA.lane_num = buf.lane_num;
-                  lane.copy(buf_TollETA.laneinfo, lane.size());
-
-                  rec_header.ETA_flag = 1;
-               }
-               else if ( eta_cnt > 1 ) {
-                  CM_LOG_WARNING("%s[Toll] unexpected the Toll ETA number %d.", LOG_HEADER, eta_cnt);
-               }
-            }
-
-            // Toll pattern : statment create/reset
-            if ( stmt_sel_TollPattern ) 
-            {
-               stmt_sel_TollPattern->reset();
-            }
-            else
-            {
-               sql = "select * from " TABLE_Toll_Pattern " where CondID == ?;";
-               stmt_sel_TollPattern = m_db->create_statement(sql.c_str());
-            }
-
-            if ( stmt_sel_TollPattern ) {
-               stmt_sel_TollPattern->bind_text(1, txtCondId.c_str());
-
-               size_t ptn_cnt = 0;
-               while ( stmt_sel_TollPattern->step_row() )
-               {
-                  size_t fld_pos = 0;
-                  std::string txtCondID_2 = stmt_sel_TollPattern->get_text(fld_pos++);
-                  std::string txtPaternNo = stmt_sel_TollPattern->get_text(fld_pos++);
-                  std::string txtArrowNo  = stmt_sel_TollPattern->get_text(fld_pos++);
-
-                  auto buf = _TollPattern_row2data(txtCondID_2, txtPaternNo, txtArrowNo);
-                  buf_TollPattern.PatterNo = buf.PatterNo;
-                  buf_TollPattern.ArrowNo  = buf.ArrowNo;
-                  ptn_cnt++;
-               }
-
-               if ( ptn_cnt == 1 ) {
-                  rec_header.ptn_flag = 1;
-               }
-               else if ( ptn_cnt > 1 ) {
-                  CM_LOG_WARNING("%s[Toll] unexpected the pattern number %d.", LOG_HEADER, ptn_cnt);
-               }
-            }
-         }
-
-         os.write(reinterpret_cast<const char*>(&rec_header), sizeof(rec_header));
-
-         if ( rec_header.ETA_flag ) {
-            os.write(reinterpret_cast<const char*>(&buf_TollETA), sizeof(buf_TollETA));
-         }
-
-         if ( rec_header.ptn_flag ) {
-            os.write(reinterpret_cast<const char*>(&buf_TollPattern), sizeof(buf_TollPattern));
-         }
-
-         for(auto i = 0; i < rec_header.cnt_CRID; ++i)
-         {
-            buf_CR = vec_CR[i];
-            os.write(reinterpret_cast<const char*>(&buf_CR), sizeof(buf_CR));
-         }
-
-         if ( ++row_num % 100 == 0 )
-         {
-            CM_LOG_INFO("%s stepped %d rows", LOG_HEADER, row_num);
-         }
-
-         //if ( row_num >= 5 )
-         if(false)
-         {
-            break;
-         }
-      }
-
-      m_db->remove_statement(stmt_sel_C);
-      m_db->remove_statement(stmt_sel_CR);
-      m_db->remove_statement(stmt_sel_TollETA);
-      m_db->remove_statement(stmt_sel_TollPattern);
-
-      uint32_t datasize = os.str().size() / 16;
-      uint32_t dirtsize = os.str().size() % 16;
-      CM_LOG_INFO("%s All stepped rows number is %d, data size %d, dirty data %d.", LOG_HEADER,
-         row_num, datasize, dirtsize);
-
-      //if (  dirtsize )
-      if(true)
-      {
-         struct alignas(16){
-            uint32_t recnum;
-            uint32_t datsiz;
-            uint64_t reserved;
-         }header = {_LE(row_num), _LE(datasize), 0};
-
-         static_assert(sizeof(header) == 16, "header is not 16 bytes!");
-
-         const char* addr = reinterpret_cast<char*>(&header);
-         bin = std::string(addr, sizeof(header)) + os.str();
-      }
-   }
-   else{
-      CM_LOG_ERROR("%s statement \"%s\" create error!", LOG_HEADER, sql.c_str());
-   }
-
-   return bin;
-}
-
-
-bool CCmDatabase::parse_db_C_CR_Toll(const char* bin_path)
-{
-   bool ok = false;
-   CM_LOG_INFO("%s parse C-CR-Toll to \"%s\" .", LOG_HEADER, bin_path);
-
-   std::ofstream ofs(bin_path);
-   if ( ofs.is_open() ) 
-   {
-      auto bin = parse_db_C_CR_Toll();
-      ofs.write(bin.data(), bin.size());
-      ok = true;
-   }
-
-   return ok;
-}
-
-bool CCmDatabase::combine_db_C_CR(const char* path_C, const char* path_CR, const char* db_path)
-{
-   bool ok = false;
-
-   if ( path_C && path_CR && db_path) 
-   {
-      if ( open_db(MEM_DB) ) 
-      {
-         const char* alias_C = "DB_C";
-         const char* alias_CR = "DB_CR";
-         ok = m_db->attach(path_C, alias_C);
-         if ( ok ) {
-            ok = m_db->attach(path_CR, alias_CR);
-            if ( ok ) 
-            {
-               std::string sql = "create table C_CR as select * from DB_C." TABLE_C " as C, DB_CR.CR as CR where C.CRID == CR.CRID;";
-               ok = m_db->execute(sql.c_str());
-               if ( ok ) 
-               {
-                  ok = m_db->detach(alias_C);
-                  if ( ok ) 
-                  {
-                     ok = m_db->detach(alias_CR);
-                     if ( ok ) 
-                     {
-                        CM_LOG_INFO("%s =======> OK" , LOG_HEADER);
-                        ok = save_as(db_path); 
-                        if ( !ok ) 
-                        {
-                           CM_LOG_WARNING("%s save as %s failed!", LOG_HEADER, db_path);
-                        }
-                     }
-                     else
-                     {
-                        CM_LOG_WARNING("%s failed detach : \"%s\"!", LOG_HEADER, alias_CR);
-                     }
-                  }
-                  else
-                  {
-                     CM_LOG_WARNING("%s failed detach : \"%s\"!", LOG_HEADER, alias_C);
-                  }
-               }
-               else
-               {
-                  CM_LOG_WARNING("%s failed create table : \"%s\"!", LOG_HEADER, sql.c_str());
-               }
-            }
-            else
-            {
-               CM_LOG_WARNING("%s failed attach : \"%s\"!", LOG_HEADER, path_CR);
-            }
-         }
-         else
-         {
-            CM_LOG_WARNING("%s failed attach : \"%s\"!", LOG_HEADER, path_C);
-         }
-      }
-   }
-   else 
-   {
-      CM_LOG_ERROR("%s illegal parameter C : %s, CR : %s, output DB path : %s", LOG_HEADER, path_C, path_CR, db_path);
-   }
-
-   return ok;
-}
-
-bool CCmDatabase::combine_db_C_CR_Toll(
-   const char* path_C, 
-   const char* path_CR, 
-   const char* path_Toll_ETA, 
-   const char* path_Toll_Pattern, 
-   const char* db_path)
-{
-   bool ok = false;
-
-   if ( path_C && path_CR && db_path && path_Toll_ETA && path_Toll_Pattern) 
-   {
-      if ( open_db(MEM_DB) ) 
-      {
-         const char* alias_C = "DB_C";
-         const char* alias_CR = "DB_CR";
-         const char* alias_Toll_ETA = "DB_Toll_ETA";
-         const char* alias_Toll_Pattern = "DB_Toll_Pattern";
-
-         std::bitset<4> grp_ret("0000");
-         grp_ret[0] = m_db->attach(path_C,            alias_C);
-         grp_ret[1] = m_db->attach(path_CR,           alias_CR);
-         grp_ret[2] = m_db->attach(path_Toll_ETA,     alias_Toll_ETA);
-         grp_ret[3] = m_db->attach(path_Toll_Pattern, alias_Toll_Pattern);
-
-         ok = grp_ret.all(); 
-         if (ok) 
-         {
-            auto tabsql = [](const char* t, const char* a)
-            {
-               std::ostringstream os;
-               os << "create table " << t << " as select * from " << a << "." << t << ";";;
-               return os.str();
-            };
-
-            grp_ret[0] = m_db->execute(tabsql(TABLE_C,            alias_C           ).c_str());
-            grp_ret[1] = m_db->execute(tabsql(TABLE_CR,           alias_CR          ).c_str());
-            grp_ret[2] = m_db->execute(tabsql(TABLE_Toll_ETA,     alias_Toll_ETA    ).c_str());
-            grp_ret[3] = m_db->execute(tabsql(TABLE_Toll_Pattern, alias_Toll_Pattern).c_str());
-
-            ok = grp_ret.all();
-            if ( ok ) 
-            {
-               grp_ret[0] = m_db->detach(alias_C);
-               grp_ret[1] = m_db->detach(alias_CR);
-               grp_ret[2] = m_db->detach(alias_Toll_ETA);
-               grp_ret[3] = m_db->detach(alias_Toll_Pattern);
-
-               ok = grp_ret.all();
-               if ( ok ) 
-               {
-                  ok = save_as(db_path); 
-                  if ( ok ) 
-                  {
-                     CM_LOG_INFO("%s combine C-CR-Toll table OK!" , LOG_HEADER);
-                  }
-                  else
-                  {
-                     CM_LOG_WARNING("%s save as %s failed!", LOG_HEADER, db_path);
-                  }
-               }
-               else
-               {
-                  CM_LOG_WARNING("%s detach tables failed %s!", LOG_HEADER, grp_ret.to_string().c_str());
-               }
-            }
-         }
-         else
-         {
-            CM_LOG_WARNING("%s attach tables failed %s!", LOG_HEADER, grp_ret.to_string().c_str());
-         }
-      }
-   }
-   else 
-   {
-      CM_LOG_ERROR("%s illegal parameter C : %s, CR : %s, Toll ETA : %s, Toll Pattern : %s, output DB path : %s", 
-         LOG_HEADER, path_C, path_CR, path_Toll_ETA, path_Toll_Pattern, db_path);
-   }
-
-
-   return ok;
-}
-
-bool CCmDatabase::do_argv(std::vector<std::string> &v)
-{
-   //CM_LOG_INFO("%s the number of arguments is %d.", LOG_HEADER, v.size());
-   bool ok = false;
-
-   std::vector<std::tuple<std::string, std::string, std::string>> vecMid, vecDB;
-   for(const auto& arg : v)
-   {
-      std::string dir, bname, ext;
-      std::tie(dir, bname, ext) = parse_path(arg);
-      if ( "mid" == ext ) {
-         vecMid.push_back(std::make_tuple(dir, bname, arg));
-      }
-      else if ( "db" == ext ) {
-         vecDB.push_back(std::make_tuple(dir, bname, arg));
-      }
-   }
-
-   std::regex ptn_N, ptn_C, ptn_CR, ptn_ETA, ptn_Pattern, ptn_C_CR_Toll, ptn_Junction;
-   std::tie(ptn_N, ptn_C, ptn_CR, ptn_ETA, ptn_Pattern, ptn_C_CR_Toll, ptn_Junction) = g_bname_ptn;
-
-   if( ! vecMid.empty() && ! vecDB.empty())
-   {
-      CM_LOG_WARNING("do on not know what to do!", LOG_HEADER);
-   }
-   else if( ! vecMid.empty())
-   {
-      std::string mid_dir;
-      auto& dst = vecMid[0];
-      if(std::all_of(vecMid.begin(), vecMid.end(), [&dst](decltype(dst)& src){return std::get<0>(src) == std::get<0>(dst);}))
-      {
-         std::tie(mid_dir, std::ignore, std::ignore) = dst;
-      }
-
-      if( 1 == vecMid.size())
-      {
-         std::string mid_path;
-         std::tie(std::ignore, std::ignore, mid_path) = dst;
-         ok = import_mid(mid_path.c_str());
-      }
-
-#if  0     /* ----- #if 0 : If0Label_1 ----- */
-      else if( 2 == vecMid.size())
-      {
-         //ok = im
-      }
-#endif     /* ----- #if 0 : If0Label_1 ----- */
-
-      else
-      {
-         CM_LOG_WARNING("%s unexpected the number(%d) of mid files!", LOG_HEADER, vecMid.size());
-      }
-   }
-   else if( ! vecDB.empty())
-   {
-      std::string out_dir;
-      auto& dst = vecDB[0];
-      if(std::all_of(vecDB.begin(), vecDB.end(), [&dst](decltype(dst)& src){return std::get<0>(src) == std::get<0>(dst);}))
-      {
-         std::tie(out_dir, std::ignore, std::ignore) = dst;
-      }
-
-      //CM_LOG_INFO("%s DB number : %d, out dir : %s.", LOG_HEADER, vecDB.size(), out_dir.c_str());
-      if( 1 == vecDB.size())
-      {
-         std::string db_path;
-         std::tie(std::ignore, std::ignore, db_path) = dst;
-         ok = parse_db(db_path.c_str());
-      }
-      else if( 2 == vecDB.size())
-      {
-         std::string path_C, path_CR;
-         std::string prvnc_C, prvnc_CR;
-         for(auto& e : vecDB)
-         {
-            std::string basname, db_path;
-            std::tie(std::ignore, basname, db_path) = e;
-            std::smatch m;
-
-            //CM_LOG_INFO("%s the DB base name \"%s\".", LOG_HEADER, basname.c_str());
-            if ( path_C.empty() && std::regex_match(basname, m, ptn_C) ) {
-               path_C = db_path;
-               prvnc_C = m[1].str();
-            }
-            else if ( path_CR.empty() && std::regex_match(basname, m, ptn_CR) ) {
-               path_CR = db_path;
-               prvnc_CR = m[1].str();
-            }
-         }
-
-         //CM_LOG_INFO("%s province C : \"%s\", province CR : \"%s\".", LOG_HEADER, prvnc_C.c_str(), prvnc_CR.c_str());
-         if((prvnc_CR == prvnc_C) && ! path_CR.empty() && ! path_C.empty())
-         {
-            std::string db_path = prvnc_C + "_C_CR.db";
-            if( ! out_dir.empty())
-            {
-               db_path = out_dir + '/' + db_path;
-            }
-            ok = combine_db_C_CR(path_C.c_str(), path_CR.c_str(),  db_path.c_str());
-         }
-      }
-      else if( 4 == vecDB.size())
-      {
-         std::string path_C,  path_CR,    path_Toll_ETA,    path_Toll_Pattern;
-         std::string prvnc_C, prvnc_CR,   prvnc_Toll_ETA,   prvnc_Toll_Pattern;
-         for(auto& e : vecDB)
-         {
-            std::string basname, db_path;
-            std::tie(std::ignore, basname, db_path) = e;
-            std::smatch m;
-
-            //CM_LOG_INFO("%s the DB base name \"%s\".", LOG_HEADER, basname.c_str());
-            if ( path_C.empty() && std::regex_match(basname, m, ptn_C) ) {
-               path_C = db_path;
-               prvnc_C = m[1].str();
-            }
-            else if ( path_CR.empty() && std::regex_match(basname, m, ptn_CR) ) {
-               path_CR = db_path;
-               prvnc_CR = m[1].str();
-            }
-            else if ( path_Toll_ETA.empty() && std::regex_match(basname, m, ptn_ETA) ) {
-               path_Toll_ETA = db_path;
-               prvnc_Toll_ETA = m[1].str();
-            }
-            else if ( path_Toll_Pattern.empty() && std::regex_match(basname, m, ptn_Pattern) ) {
-               path_Toll_Pattern = db_path;
-               prvnc_Toll_Pattern = m[1].str();
-            }
-         }
-
-         // checking helpers
-         std::vector<std::string> ref_prvnc{ std::ref(prvnc_C),   std::ref(prvnc_CR),  std::ref(prvnc_Toll_ETA),  std::ref(prvnc_Toll_Pattern)};  
-         std::vector<std::string> ref_path{  std::ref(path_C),    std::ref(path_CR),   std::ref(path_Toll_ETA),   std::ref(path_Toll_Pattern)};  
-
-         auto province = ref_prvnc[0];
-         if ( std::all_of(ref_prvnc.begin(), ref_prvnc.end(), [&province](std::string& s){return s == province;}) 
-           && std::all_of(ref_path.begin(),  ref_path.end(),  [](std::string& s){return !s.empty();})) 
-         {
-            std::string db_path = province + "_C_CR_Toll.db";
-            if( ! out_dir.empty())
-            {
-               db_path = out_dir + '/' + db_path;
-            }
-            ok = combine_db_C_CR_Toll(path_C.c_str(), path_CR.c_str(), path_Toll_ETA.c_str(), path_Toll_Pattern.c_str(), db_path.c_str());
-         }
-         else
-         {
-            CM_LOG_WARNING("%s checking failed!", LOG_HEADER);
-         }
-      }
-      else
-      {
-         CM_LOG_WARNING("%s unexpected the number(%d) of DB files!", LOG_HEADER, vecDB.size());
-      }
-   }
-   else
-   {
-      CM_LOG_WARNING("%s No input available!!", LOG_HEADER);
-   }
-
-   return ok;
-}
+/*!
+ *    \file  cm_db.cpp
+ *   \brief  the database implement for compiler
+ *  
+ *  the class routine things
+ *  
+ *  \author  Wang Xiaolong (WXL), wangxl3@mapbar.com
+ *  
+ *  \internal
+ *       Created:  11/28/2016
+ *      Revision:  none
+ *      Compiler:  gcc
+ *  Organization:  mapbar co.
+ *     Copyright:  mapbar
+ *  
+ *  This source code is released for free distribution under the terms of the
+ *  GNU General Public License as published by the Free Software Foundation.
+ */
+
+/*!
+ * @page pg_srch Page for search target data
+ * @brief This page introduce how to search target data such as CR, toll info or HW info.
+ * @section sec1 reach the CR info
+ * @subsection subsec_1_1 CR info binary format
+ * @brief The CR info is up to 16 bytes.
+ * @details The bit sequence is like following.
+ * @verbatim
+00~07 bytes: XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXXXX
+             63             48 |  ||||| 39                                           0
+             |               | |  ||||| |                                            |
+             \---------------/ \  /|||| \------------------- CRID -------------------/
+                  VPeriod16     \/ ||||
+                                /  ||||
+           VPeri_Type <--------/   ||||
+                                   \/||
+           VP_Approx <-------------/ ||
+                                     \/
+           VPDir <-------------------/
+
+08~15 bytes: XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXX XXXXXXXXXX
+             127                              96 95                                 64
+             |                                 | |                                   |
+             \------------- Vehcl_Type --------/ \------------- VPeriod32 -----------/
+   @endverbatim
+ *
+ * @subsection subsec_1_2 field detail
+ *
+ * -# bit 0~39, 40 bits : CRID
+ * -# bit 40~41, 2 bits : VPDir, indicate the restrict direction. The value range is [0, 3].\n
+ *  - case value == 0 : Default value. The meaning is no direction.
+ *  - case value == 1 : Restriction on the bidirections.
+ *  - case value == 2 : Restriction on the order direction.
+ *  - case value == 3 : Restriction on the reverse direction.
+ * -# bit 42~43, 2 bits : VP_Approx, the value indacates the aproximation for VPeriod. The value ranges as [0, 2].
+    - case value == 0 : Not available.
+    - case value == 1 : Not the value approximated.
+    - case value == 2 : The value is approximated.
+    - case value == 3 : Not defined.
+ * -# bit 44~47, 4 bits : VPeri_Type, value range [0,2].\n
+ *  - case value == 0 : not available
+ *  - case value == 1 : MMdd V.S. hhmm
+ *  - case value == 2 : hhmm V.S. t1~t7
+ *  - case other value: not defined
+ * -# bit 48~95, 48 bits: VPeriod, the bit sequence rules the time of traffic regulation.
+    - case VPeri_Type == 1 :
+     - the part VPeriod16 : bit 48~63, 16 bits.
+      -# bit 48~51, 4 bits, start month. The value ranges [0, 12].
+       - case value == 0 : not available.
+       - case value == 1..12 : Jan .. Dec.
+       - case other value : not defined.
+      -# bit 52~55, 4 bits, end month. The value ranges [0, 12].
+       - case value == 0 : not available.
+       - case value == 1..12 : Jan .. Dec.
+       - case other value : not defined.
+      -# bit 56~63, 8 bits, not defined.
+     - the part VPeriod32 : bit 64~95, 32 bits.
+      -# bit 64~68, 5 bits, start date. The value ranges [0, 31].
+       - case value == 0 : not available.
+       - case value == 1..31 : The day in a month.
+      -# bit 69~73, 5 bits, end date. The value ranges [0, 31].
+       - case value == 0 : not available.
+       - case value == 1..31 : The day in a month.
+      -# bit 74~78, 5 bits, start hour. The value ranges [0, 23].
+       - case value == 0..23 : hour.
+       - case the other value : not available.
+      -# bit 79~83, 5 bits, end hour. The value ranges [0, 23].
+       - case value == 0..23 : hour.
+       - case the other value : not available.
+      -# bit 84~89, 6 bits, start miniute. The value ranges [0, 59].
+       - case value == 0..59 : minute.
+       - case the other value : not available.
+      -# bit 90~95, 6 bits, start miniute. The value ranges [0, 59].
+       - case value == 0..59 : minute.
+       - case the other value : not available.
+    - case VPeri_Type == 2 :
+     - the part VPeriod16 : bit 48~63, 16 bits. Not defined.
+     - the part VPeriod32 : bit 64~95, 32 bits.
+      -# bit 64~70, 7 bits, bit sequence. 
+       - bit 0..6 : Sun, Mon..Sat.
+      -# bit 71~73, 3 bits, not defined.
+      -# bit 74~78, 5 bits, start hour. The value ranges [0, 23].
+       - case value == 0..23 : hour.
+       - case the other value : not available.
+      -# bit 79~83, 5 bits, end hour. The value ranges [0, 23].
+       - case value == 0..23 : hour.
+       - case the other value : not available.
+      -# bit 84~89, 6 bits, start miniute. The value ranges [0, 59].
+       - case value == 0..59 : minute.
+       - case the other value : not available.
+      -# bit 90~95, 6 bits, start miniute. The value ranges [0, 59].
+       - case value == 0..59 : minute.
+       - case the other value : not available.
+
+    - case VPeri_Type == 3 :
+     - the part VPeriod16 : bit 48~63, 16 bits. Not defined.
+     - the part VPeriod32 : bit 64~95, 32 bits.
+      -# bit 64~73, 10 bits, not defined.
+      -# bit 74~78, 5 bits, start hour. The value ranges [0, 23].
+       - case value == 0..23 : hour.
+       - case the other value : not available.
+      -# bit 79~83, 5 bits, end hour. The value ranges [0, 23].
+       - case value == 0..23 : hour.
+       - case the other value : not available.
+      -# bit 84~89, 6 bits, start miniute. The value ranges [0, 59].
+       - case value == 0..59 : minute.
+       - case the other value : not available.
+      -# bit 90~95, 6 bits, start miniute. The value ranges [0, 59].
+       - case value == 0..59 : minute.
+       - case the other value : not available.
+ * @section sec2 reach the Toll info
+ * - The ETA info
+ *   One toll ETA info is up to 8 bytes.
+ *   The fields in one toll ETA info is like following.
+ *  -# bit 00~39, 40 bits : condion ID.
+ *  -# bit 40~43,  4 bits : toll type.
+ *  -# bit 44~47,  4 bits : lane number.
+ *  -# bit 48~63, 16 bits : not defined.
+ * - The Pattern Info
+ *   One toll pattern info is up to 16 bytes.
+ *   The fields in one toll pattern info is like following.
+ *  -# bit 00~39, 40 bits : condion ID.
+ *  -# bit 40~63, 24 bits : not defined.
+ *  -# bit 64~95, 32 bits : pattern number.
+ *  -# bit 96~127, 32 bits : arrow nubmer.
+ * @section sec3 reach the HW Junction info
+ * @brief One HW Junction info is up to 24 bytes and has 3 parts. 
+ *  The part 1 is 8 bytes. The part 2 is 6 bytes and the part 3 is 10 bytes.
+ * @details the fields in these files are like following.
+ * - part 1 : 8 bytes.
+ *  -# bit 00~39, 40 bits : ID
+ *  -# bit 40~47,  8 bits : not defined.
+ *  -# bit 48~51,  4 bits : access type.
+ *  -# bit 52~55,  4 bits : attribute.
+ *  -# bit 56~63,  8 bits : estab item.
+ *   - bit 56 : 1, restaurant. 0 , no restaurant available.
+ *   - bit 57 : 1, shop. 0, no shop available.
+ *   - bit 58 : 1, inn. 0, no inn available.
+ *   - bit 59 : 1, public toilet. 0, no public toilet available.
+ *   - bit 60~63 : Natural number, the gasoline station.
+ *    - value == 21 : PetreChina.
+ *    - value == 22 : sinopec
+ *    - value == 23 : shell
+ *    - value == 24 : Mobil
+ *    - value == 25 : Brithish Petroleum
+ *    - value == 26 : other
+ * - part 2 : 6 bytes.
+ *  bit 00~39, 40 bits : NodeID
+ *  bit 40~63, 16 bits : not defined.
+ * - part 3 : 10 bytes.
+ *  -# byte 0~4 : inLinkID.
+ *  -# byte 5~9 : outLinkID.
+ * @section sec4 reach the node neighbors
+ * @brief The N bin is the adjacency of the nodes in CSR, a 16 bytes header
+ *  {node number, neighbor number, link number, 0} and 6 sections, each padded
+ *  to 16 bytes.
+ * @details The sections are like following.
+ * - ids : u64 x n, the node IDs in ascending order.
+ * - attr : u32 x n, bit 0~3 Cross_flag, bit 4~7 Light_flag, bit 8~31 MapID.
+ * - nbr_off : u32 x (n + 1), the neighbors of the node i are nbr[nbr_off[i], nbr_off[i + 1]).
+ * - nbr : u64.
+ *  -# bit 00~39, 40 bits : neighbor ID.
+ *  -# bit 40~43,  4 bits : kind, 1 main node, 2 sub node, 3 adjoined node.
+ *  -# bit 44~63, 20 bits : MapID of the adjoined node, 0 for the others.
+ * - link_off : u32 x (n + 1), the links of the node i are link[link_off[i], link_off[i + 1]).
+ * - link : u64, the link IDs.
+ */
+//-----------------------------------------------------------------------------
+//  Header Section
+//-----------------------------------------------------------------------------
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <sstream>
+#include <array>
+#include <algorithm>
+#include <bitset>
+#include <type_traits>
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <unordered_map>
+#include "cm_db.hpp"
+#include "cm_arena.hpp"
+#include "cm_check.hpp"
+#include "cm_conv.hpp"
+#include "cm_memo.hpp"
+#include "cm_mid.hpp"
+#include "cm_pack.hpp"
+#include "cm_scan.hpp"
+#include "cm_spill.hpp"
+#include "cm_writer.hpp"
+#include "cm_debug.h"
+
+//-----------------------------------------------------------------------------
+//  MACRO Defination
+//-----------------------------------------------------------------------------
+#define LOG_HEADER "[CM_DB]"
+
+#define TABLE_N            "N"
+#define TABLE_C            "C"
+#define TABLE_CR           "CR"
+#define TABLE_C_CR         "C_CR"
+#define TABLE_Toll_ETA     "Toll_ETA"
+#define TABLE_Toll_Pattern "Toll_Pattern"
+#define TABLE_HW_Junction  "HW_Junction"
+#define MEM_DB             ":memory:"
+#define WORK_DB_EXT        ".work"
+
+//-----------------------------------------------------------------------------
+//  Constants Defination
+//-----------------------------------------------------------------------------
+static const int VP_INVALID_HOUR = 24;
+static const int VP_INVALID_MINUTE = 60;
+static const size_t ROW_BATCH = 1024;     ///< rows between the arena resets
+static const size_t REJECT_LOG_NUM = 8;  ///< the rejected mid lines logged one by one
+static const uint64_t PROBE_ROWIDS = 4096;   ///< the rowids of a range in the first round under the memory limit
+static const uint32_t C_CR_TOLL_FLAG_DICT = 0x01;  ///< the CR dictionary follows the records
+static const uint32_t C_CR_TOLL_FLAG_TILE = 0x02;  ///< the tile directory follows the header
+static const uint32_t TILE_MAGIC = 0x4C49544D;     ///< "MTIL" of the tile directory
+static const uint32_t C_CR_TOLL_FLAG_SLOT = 0x04;  ///< the VPeriod slot table follows the dictionary
+static const uint32_t C_CR_TOLL_FLAG_VEH = 0x08;   ///< the vehicle class index follows the slot table
+static const uint32_t C_CR_TOLL_FLAG_EXT = 0x10;   ///< the records may carry the extension blocks
+static const uint64_t N_NBR_MAIN = 1;     ///< the neighbor is the main node of the node
+static const uint64_t N_NBR_SUB = 2;      ///< the neighbor is a sub node of the node
+static const uint64_t N_NBR_ADJOIN = 3;   ///< the neighbor is the node adjoined in the other mesh
+static const size_t C_CR_MAX = 15;       ///< the CRs of a C-CR-Toll record, cnt_CRID is 4 bits
+static const size_t LANE_ALIGN = 8;      ///< the lane bytes of Toll ETA are padded to
+static const size_t C_EXT_MAX = 0xFFFF;  ///< the CRs or the lanes of an extension block, 16 bits
+static const size_t ETA_LANE_MAX = 15;   ///< the lanes of lane_num, 4 bits, and of the ETA block of C-CR-Toll
+
+//-----------------------------------------------------------------------------
+//  Type Defination
+//-----------------------------------------------------------------------------
+struct alignas(16) CR_RowData {
+   uint64_t CRID : 40;              /* 5 bytes */
+   uint32_t VPDir: 2;               /* 2/8 byte */
+   uint32_t VP_Approx : 2;          /* 2/8 byte */
+   uint32_t VPeri_Type : 4;         /* 4/8 byte */
+   uint16_t VPeriod16;              /* 2 bytes */
+   uint32_t VPeriod32;              /* 4 bytes */
+   uint32_t Vehcl_Type;             /* 4 bytes */
+} ;
+struct alignas(8) TollETA_RowData{
+   uint64_t CondID : 40;
+   uint32_t TollType : 4;
+   uint32_t lane_num : 4;              // the first ETA_LANE_MAX lanes at most
+   uint32_t ext_lane : 16;             // the lanes after the ones of lane_num, C_EXT_MAX at most
+};
+struct alignas(16) TollPattern_RowData{
+   uint64_t CondID : 40;            /* 5 bytes */
+   uint32_t : 24;                   /* 3 bytes : padding */
+   uint32_t PatterNo;               /* 4 bytes */
+   uint32_t ArrowNo;                /* 4 bytes */
+};
+
+// the blocks of the C-CR-Toll record
+struct alignas(16) C_RecHeader {
+   uint64_t InLinkId : 40;             /* 5 bytes */
+   uint64_t OutLinkId : 40;            /* 5 bytes */
+   uint8_t  CondType : 4;              // half byte
+   uint32_t cnt_CRID : 4;              // half byte
+   uint8_t  ETA_flag : 1;              /* 1/8 byte */
+   uint8_t  ptn_flag : 1;              /* 1/8 byte */
+   uint8_t  cr_dict : 1;               // 1/8 byte : the CRs are the indexes of the dictionary
+   uint8_t  ext_flag : 1;              // 1/8 byte : the extension block follows the CRs
+};
+struct alignas(16) C_CRBlock {
+   uint32_t VPDir: 2;                  /* 2/8 byte */
+   uint32_t VP_Approx : 2;             /* 2/8 byte */
+   uint32_t VPeri_Type : 4;            /* 4/8 byte */
+   uint32_t slot : 16;                 // 2 bytes : the index of the VPeriod slot entry
+   uint8_t  reserved[3];               // 3 bytes
+   uint16_t VPeriod16;                 /* 2 bytes */
+   uint32_t VPeriod32;                 /* 4 bytes */
+   uint32_t Vehcl_Type;                /* 4 bytes */
+};
+struct alignas(16) C_TollETABlock {
+   uint32_t ETA_type : 4;              /* half byte */
+   uint32_t lane_num : 4;              /* half byte */
+   char     laneinfo[15];              /* 15 bytes */
+};
+struct alignas(16) C_TollPatternBlock {
+   uint32_t PatterNo;                  /* 4 bytes */
+   uint32_t ArrowNo;                   /* 4 bytes */
+};
+
+static_assert(sizeof(C_RecHeader) == 16, "The buffer for C table is not 16 bytes;");
+static_assert(sizeof(C_CRBlock) == 16, "buffer CR is not 16 bytes");
+static_assert(sizeof(C_TollETABlock) == 16, "The buffer for toll table is not 16 bytes;");
+static_assert(sizeof(C_TollETABlock::laneinfo) == ETA_LANE_MAX, "The lanes of the ETA block are not ETA_LANE_MAX;");
+static_assert(sizeof(C_TollPatternBlock) == 16, "The buffer for toll table is not 16 bytes;");
+
+/*!
+ *  \brief  the layouts of the records in the bins
+ *
+ *  The structures above hold the values only. The records are written as
+ *  the 64 bits words of CCmWords in the byte order of the bin, and the
+ *  fields are the bits of the words. In the little endian bins they are the
+ *  same bytes as gcc packed the bit fields on x86, which were written as
+ *  they were before. The ETA block and the lanes are bytes.
+ */
+struct CR_Layout                          // 2 words
+{
+   typedef CCmField<0,  0, 40> CRID;
+   typedef CCmField<0, 40,  2> VPDir;
+   typedef CCmField<0, 42,  2> VP_Approx;
+   typedef CCmField<0, 44,  4> VPeri_Type;
+   typedef CCmField<0, 48, 16> VPeriod16;
+   typedef CCmField<1,  0, 32> VPeriod32;
+   typedef CCmField<1, 32, 32> Vehcl_Type;
+};
+struct TollETA_Layout                     // 1 word, the lanes follow
+{
+   typedef CCmField<0,  0, 40> CondID;
+   typedef CCmField<0, 40,  4> TollType;
+   typedef CCmField<0, 44,  4> lane_num;
+   typedef CCmField<0, 48, 16> ext_lane;      ///< the lanes after the ones of lane_num, with the overflow
+};
+struct TollPattern_Layout                 // 2 words
+{
+   typedef CCmField<0,  0, 40> CondID;
+   typedef CCmField<1,  0, 32> PatterNo;
+   typedef CCmField<1, 32, 32> ArrowNo;
+};
+struct HW_Junction_Layout                 // 3 words
+{
+   typedef CCmField<0,  0, 40> ID;
+   typedef CCmField<0, 48,  4> AccessType;
+   typedef CCmField<0, 52,  4> Attr;
+   typedef CCmField<0, 56,  8> Estab_item;
+   typedef CCmField<1,  0, 40> NodeID;
+   typedef CCmField<1, 40, 24> inLinkID_lo;   ///< the low 24 bits
+   typedef CCmField<2,  0, 16> inLinkID_hi;   ///< the bits 24~39
+   typedef CCmField<2, 16, 40> outLinkID;
+};
+struct C_RecHeader_Layout                 // 2 words
+{
+   typedef CCmField<0,  0, 40> InLinkId;
+   typedef CCmField<0, 40, 24> OutLinkId_lo;  ///< the low 24 bits
+   typedef CCmField<1,  0, 16> OutLinkId_hi;  ///< the bits 24~39
+   typedef CCmField<1, 16,  4> CondType;
+   typedef CCmField<1, 20,  4> cnt_CRID;
+   typedef CCmField<1, 24,  1> ETA_flag;
+   typedef CCmField<1, 25,  1> ptn_flag;
+   typedef CCmField<1, 26,  1> cr_dict;
+   typedef CCmField<1, 27,  1> ext_flag;
+};
+struct C_RecExt_Layout                    // 2 words, the CRs and the lanes follow
+{
+   typedef CCmField<0,  0, 16> cnt_CRID;      ///< the CRs after the ones of the record
+   typedef CCmField<0, 16, 16> lane_num;      ///< the lanes after the ones of the ETA block
+};
+struct C_CRBlock_Layout                   // 2 words
+{
+   typedef CCmField<0,  0,  2> VPDir;
+   typedef CCmField<0,  2,  2> VP_Approx;
+   typedef CCmField<0,  4,  4> VPeri_Type;
+   typedef CCmField<0,  8, 16> slot;
+   typedef CCmField<0, 48, 16> VPeriod16;
+   typedef CCmField<1,  0, 32> VPeriod32;
+   typedef CCmField<1, 32, 32> Vehcl_Type;
+};
+struct C_TollPattern_Layout               // 2 words
+{
+   typedef CCmField<0,  0, 32> PatterNo;
+   typedef CCmField<0, 32, 32> ArrowNo;
+};
+
+/// \brief one record of the C-CR-Toll bin
+struct C_CR_Toll_Record
+{
+   C_RecHeader header;
+   C_TollETABlock eta;
+   C_TollPatternBlock pattern;
+   std::vector<C_CRBlock> cr;          ///< the capacity is kept from record to record
+   std::string lane;                   ///< the lanes over the ETA block, with the overflow
+   std::vector<uint16_t> idx;          ///< the dictionary indexes of the CRs over cnt_CRID
+   bool overflow = false;              ///< the CRs and the lanes over the limits are kept for the extension block
+};
+
+/*!
+ *  \brief  the dictionary of the unique CR blocks of the C-CR-Toll bin
+ *
+ *  The CR blocks of many records are the same. In the dictionary mode they
+ *  are written once after the records in the order of their first use, and
+ *  the records refer to them by 2 bytes indexes.
+ */
+struct C_CRDict
+{
+   static const size_t max_size = 65536;
+
+   struct key_hash
+   {
+      size_t operator()(const std::pair<uint64_t, uint64_t>& k) const
+      {
+         return std::hash<uint64_t>()(k.first * 0x9E3779B97F4A7C15ULL ^ k.second);
+      }
+   };
+
+   std::unordered_map<std::pair<uint64_t, uint64_t>, uint16_t, key_hash> index;
+   std::vector<C_CRBlock> block;
+   size_t refs = 0;                    ///< the CRs referred by index
+
+   /// \brief the index of the block, which is added if it is new, false if the dictionary is full
+   bool find(const C_CRBlock& b, uint16_t& idx)
+   {
+      std::pair<uint64_t, uint64_t> key;
+      std::memcpy(&key.first, &b, sizeof(key.first));
+      std::memcpy(&key.second, reinterpret_cast<const char*>(&b) + sizeof(key.first), sizeof(key.second));
+
+      auto it = index.find(key);
+      bool ok = index.end() != it || block.size() < max_size;
+      if ( index.end() != it )
+      {
+         idx = it->second;
+      }
+      else if ( ok )
+      {
+         idx = static_cast<uint16_t>(block.size());
+         index.emplace(key, idx);
+         block.push_back(b);
+      }
+      return ok;
+   }
+};
+
+/*!
+ *  \brief  the weekly time slots of the VPeriods of the C-CR-Toll bin
+ *
+ *  Each VPeriod is expanded once into a 7 x 96 bitmap of 15 minutes slots,
+ *  from Sunday 00:00, and the range of the dates. The CR blocks refer to
+ *  the entries by 2 bytes indexes, so the runtime tests one bit instead of
+ *  decoding the VPeriod. The same entries of different VPeriods are shared.
+ */
+struct C_VPSlots
+{
+   static const size_t days = 7;
+   static const size_t slots = 96;           ///< of a day
+   static const uint16_t none = 0xFFFF;      ///< not in the full table
+
+   struct alignas(16) entry
+   {
+      uint8_t bitmap[days * slots / 8];      ///< the bit 96 * day + slot
+      uint8_t M1, d1, M2, d2;                ///< the dates, 0 for not limited
+      uint8_t reserved[8];
+   };
+
+   std::unordered_map<uint64_t, uint16_t> code;    ///< by the VPeriod code
+   std::unordered_map<std::string, uint16_t> index;
+   std::vector<entry> table;
+   size_t refs = 0;
+
+   void refer(C_CRBlock&);
+   uint16_t add(const C_CRBlock&);
+};
+
+/*!
+ *  \brief  the records of the C-CR-Toll bin by the vehicle classes
+ *
+ *  For each bit of Vehcl_Type, the ordinals of the records which have a CR
+ *  of the bit are kept, and written as a Roaring bitmap : the ordinals are
+ *  grouped by their high 16 bits, and the low 16 bits of a group are a
+ *  sorted array of uint16, or a bitmap of 8192 bytes for more than 4096 of
+ *  them.
+ */
+struct C_VehIndex
+{
+   static const size_t classes = 32;
+   static const size_t array_max = 4096;
+
+   std::vector<uint32_t> ord[classes];
+   uint32_t next = 0;                        ///< the ordinal of the next record
+
+   void add(const C_CR_Toll_Record&);
+   std::string serialize(bool) const;
+};
+
+/// \brief the tables shared by the records of the C-CR-Toll bin, built as the records are written in order
+struct C_RecTables
+{
+   C_CRDict* dict;
+   C_VPSlots* slots;
+   C_VehIndex* veh;
+
+   bool empty() const { return nullptr == dict && nullptr == slots && nullptr == veh; }
+};
+
+/// \brief row counter of the parsing loops
+///
+/// The arena is reset every ROW_BATCH rows. After the first batch has warmed
+/// the statements and the arena blocks up, the rows should not allocate from
+/// the heap any more, which is reported in the build with CM_ALLOC_COUNT.
+struct row_batch
+{
+   const char* what;
+   size_t rows;
+   size_t skipped;                     ///< the rows of the bad numbers, which are not written
+   unsigned long long alloc_start;
+   unsigned long long alloc_warm;
+
+   explicit row_batch(const char* w) : what(w), rows(0), skipped(0), alloc_start(cm_alloc_count()), alloc_warm(alloc_start) {}
+
+   void skip(CCmArena& arena)
+   {
+      skipped++;
+      row(arena);
+   }
+
+   void row(CCmArena& arena)
+   {
+      if ( 0 == ++rows % ROW_BATCH )
+      {
+         arena.reset();
+         if ( ROW_BATCH == rows )
+         {
+            alloc_warm = cm_alloc_count();
+         }
+      }
+   }
+
+   void report(const CCmArena& arena) const
+   {
+#ifdef CM_ALLOC_COUNT
+      auto alloc_end = cm_alloc_count();
+      CM_LOG_INFO("%s %s %zu rows, %llu heap allocations, %llu after the first %zu rows, %zu arena blocks.",
+         LOG_HEADER, what, rows, alloc_end - alloc_start, (rows > ROW_BATCH) ? alloc_end - alloc_warm : 0ULL,
+         ROW_BATCH, arena.block_num());
+#else
+      CM_LOG_INFO("%s %s %zu rows, %zu arena blocks.", LOG_HEADER, what, rows, arena.block_num());
+#endif
+      if ( skipped > 0 )
+      {
+         CM_LOG_WARNING("%s %s %zu rows skipped for the bad numbers.", LOG_HEADER, what, skipped);
+      }
+   }
+};
+
+/// \brief the encoded VPeriod of CR
+struct vp_code
+{
+   uint16_t peri16;
+   uint32_t peri32;
+   uint32_t type;
+};
+
+/// \brief the lane bytes of a lane list, not ok if a lane of it is a bad number
+struct lane_code
+{
+   std::string lane;
+   bool ok;
+};
+
+/// \brief the memos of the texts repeated in the rows of a table
+///
+/// Most of the VPeriod and the lane lists of the national data are a few
+/// texts, which are parsed once and looked up by the rows after.
+struct row_memo
+{
+   CCmMemo<vp_code> vperiod;
+   CCmMemo<lane_code> toll_mode;
+   CCmMemo<lane_code> toll_card;
+
+   void report() const
+   {
+      report_memo("VPeriod", vperiod);
+      report_memo("TollMode", toll_mode);
+      report_memo("TollCard", toll_card);
+   }
+
+   template<typename V>
+   static void report_memo(const char* what, const CCmMemo<V>& m)
+   {
+      if ( m.hit() + m.miss() > 0 )
+      {
+         CM_LOG_INFO("%s %s memo %zu hits, %zu misses, %.1f%% hit rate, %zu texts.", LOG_HEADER, what,
+            m.hit(), m.miss(), 100.0 * m.hit() / (m.hit() + m.miss()), m.size());
+      }
+   }
+};
+
+/// \brief the encoded rows of a rowid range, into the bin or a buffer of its own
+struct CCmRangeOut
+{
+   CCmBinWriter* bin;                     ///< null for the buffer
+   std::string buf;
+   size_t rows;
+   size_t size;                           ///< the bytes written
+   bool big;                              ///< the words are written in big endian
+   bool tiled;                            ///< the MapIDs of the records are marked
+   std::vector<std::pair<uint32_t, size_t>> mark;  ///< MapID and offset in the buffer of the records
+
+   CCmRangeOut(CCmBinWriter* b, bool be, bool t = false) : bin(b), rows(0), size(0), big(be), tiled(t) {}
+
+   bool big_endian() const { return big; }
+
+   /// \brief mark the start of a record of the mesh in the buffer
+   void tile(uint32_t mapid)
+   {
+      mark.push_back(std::make_pair(mapid, buf.size()));
+   }
+
+   void write(const void* p, size_t n)
+   {
+      if ( bin ) {
+         bin->write(p, n);
+      }
+      else {
+         buf.append(static_cast<const char*>(p), n);
+      }
+      size += n;
+   }
+};
+
+/// \brief field of a mid file, i.e. column of its table
+struct CCmMidColumn
+{
+   const char* name;
+   bool id;                               ///< stored as INTEGER in the typed schema
+   const char* constraint;                ///< more constraint after "not null"
+};
+
+/*!
+ *  \brief  the schemas of the tables, one for each mid file
+ *
+ *  The enum gives the position of each field, which is the same in the mid
+ *  line, the insert statement and the rows of "select *", so the fields are
+ *  named by it where they are bound or read. cols[] is in the same order.
+ */
+struct schema_N
+{
+   enum {
+      MapID, ID, Kind_num, Kind, Cross_flag, Light_flag, Cross_LID, mainNodeID,
+      subNodeID, subNodeID2, Adjoin_MID, Adjoin_NID, Node_LID, FIELD_NUM
+   };
+   static const char* const table;
+   static const CCmMidColumn cols[FIELD_NUM];
+};
+const char* const schema_N::table = TABLE_N;
+const CCmMidColumn schema_N::cols[FIELD_NUM] = {
+   {"MapID",         false},
+   {"ID",            true},
+   {"Kind_num",      false},
+   {"Kind",          false},
+   {"Cross_flag",    false},
+   {"Light_flag",    false},
+   {"Cross_LID",     false},
+   {"mainNodeID",    true},
+   {"subNodeID",     false},
+   {"subNodeID2",    false},
+   {"Adjoin_MID",    false},
+   {"Adjoin_NID",    true},
+   {"Node_LID",      false},
+};
+
+struct schema_C
+{
+   enum {
+      MapID, CondID, ID, inLinkId, outLinkId, CondType, CRID, Passage, Slope,
+      SGNL_LOCTION, FIELD_NUM
+   };
+   static const char* const table;
+   static const CCmMidColumn cols[FIELD_NUM];
+};
+const char* const schema_C::table = TABLE_C;
+const CCmMidColumn schema_C::cols[FIELD_NUM] = {
+   {"MapID",         false},
+   {"CondID",        true},
+   {"ID",            true},
+   {"inLinkId",      true},
+   {"outLinkId",     true},
+   {"CondType",      true},
+   {"CRID",          true},
+   {"Passage",       false},
+   {"Slope",         false},
+   {"SGNL_LOCTION",  false},
+};
+
+struct schema_CR
+{
+   enum { CRID, VPeriod, VPDir, Vehcl_Type, VP_Approx, FIELD_NUM };
+   static const char* const table;
+   static const CCmMidColumn cols[FIELD_NUM];
+};
+const char* const schema_CR::table = TABLE_CR;
+const CCmMidColumn schema_CR::cols[FIELD_NUM] = {
+   {"CRID",          true},            // CRID field is not set as primary key, because is could be multiple
+   {"VPeriod",       false},
+   {"VPDir",         false},
+   {"Vehcl_Type",    false},           // binary digits, the leading zeros count
+   {"VP_Approx",     false},
+};
+
+struct schema_Toll_ETA
+{
+   enum { CondId, TollMode, CardMode, TollType, FIELD_NUM };
+   static const char* const table;
+   static const CCmMidColumn cols[FIELD_NUM];
+};
+const char* const schema_Toll_ETA::table = TABLE_Toll_ETA;
+const CCmMidColumn schema_Toll_ETA::cols[FIELD_NUM] = {
+   {"CondId",        true,    "unique"},
+   {"TollMode",      false},
+   {"CardMode",      false},
+   {"TollType",      false},
+};
+
+struct schema_Toll_Pattern
+{
+   enum { CondId, Pattern, ArrowNo, FIELD_NUM };
+   static const char* const table;
+   static const CCmMidColumn cols[FIELD_NUM];
+};
+const char* const schema_Toll_Pattern::table = TABLE_Toll_Pattern;
+const CCmMidColumn schema_Toll_Pattern::cols[FIELD_NUM] = {
+   {"CondId",        true,    "unique"},
+   {"Pattern",       false},           // hex digits after a letter
+   {"ArrowNo",       false},
+};
+
+struct schema_HW_Junction
+{
+   enum {
+      MapID, ID, NodeID, inLinkID, outLinkID, AccessType, Attr, Dis_Betw,
+      Seq_Nm, HW_PID, Estab_Item, FIELD_NUM
+   };
+   static const char* const table;
+   static const CCmMidColumn cols[FIELD_NUM];
+};
+const char* const schema_HW_Junction::table = TABLE_HW_Junction;
+const CCmMidColumn schema_HW_Junction::cols[FIELD_NUM] = {
+   {"MapID",         false},           /* #1 */
+   {"ID",            true},
+   {"NodeID",        true},
+   {"inLinkID",      true},
+   {"outLinkID",     true},
+   {"AccessType",    false},           /* #6 */
+   {"Attr",          false},
+   {"Dis_Betw",      false},
+   {"Seq_Nm",        false},
+   {"HW_PID",        false},
+   {"Estab_Item",    false},           /* #11 */
+};
+
+/// \brief true if all the fields are named, i.e. cols[] is no shorter than the enum
+template<typename S>
+static bool _schema_named()
+{
+   for (size_t i = 0; i < S::FIELD_NUM; ++i)
+   {
+      if ( nullptr == S::cols[i].name )
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+/// \brief the kinds of the mid and db files, told by their basenames
+enum bname_kind
+{
+   BNAME_NONE,
+   BNAME_N,
+   BNAME_C,
+   BNAME_CR,
+   BNAME_Toll_ETA,
+   BNAME_Toll_Pattern,
+   BNAME_C_CR_Toll,
+   BNAME_HW_Junction,
+};
+
+/// \brief the basename of a kind is the prefix, the province if any, and the suffix
+struct bname_rule
+{
+   const char* prefix;
+   const char* suffix;
+   bool province;
+   bname_kind kind;
+};
+//-----------------------------------------------------------------------------
+//  Local Varibles Declaration
+//-----------------------------------------------------------------------------
+/// \brief the provinces in the basenames, add the new one here
+static const char* const g_province[] = {
+   "beijing",
+   "liaoning",
+   "tianjin",
+};
+
+static const bname_rule g_bname_rule[] = {
+   {"N",             "",            true,    BNAME_N},
+   {"C",             "",            true,    BNAME_C},
+   {"CR",            "",            true,    BNAME_CR},
+   {"Toll_ETA",      "",            true,    BNAME_Toll_ETA},
+   {"Toll_Pattern",  "",            true,    BNAME_Toll_Pattern},
+   {"",              "_C_CR_Toll",  true,    BNAME_C_CR_Toll},
+   {"HW_Junction",   "",            false,   BNAME_HW_Junction},
+};
+
+//-----------------------------------------------------------------------------
+//  Local Utility
+//-----------------------------------------------------------------------------
+/// \brief the integer in the byte order of the bins, big endian or not
+template<typename T>
+T _ord(T n, bool big)
+{
+   static_assert(std::is_integral<T>::value, "_ord");
+   typedef typename std::make_unsigned<T>::type U;
+   return static_cast<T>(cm_order(static_cast<U>(n), big));
+}
+
+/// \brief write the words of the record in the byte order of the output
+template<typename O, size_t N>
+static void _write_words(O& os, const CCmWords<N>& w)
+{
+   char buf[sizeof(w.w)];
+   w.store(buf, os.big_endian());
+   os.write(buf, sizeof(buf));
+}
+
+/// \brief read the words of the record written by _write_words
+template<size_t N>
+static CCmWords<N> _read_words(const char* p, bool big)
+{
+   CCmWords<N> w;
+   w.load(p, big);
+   return w;
+}
+
+template<typename T>
+inline void _bzero(T& r)
+{
+   auto addr = reinterpret_cast<char*>(&r);
+   static_assert(std::is_pod<T>::value, "_bzero");
+   std::fill_n(addr, sizeof(r), '\0');
+}
+
+/// \brief call f with every non empty piece of s divided by delim
+template<typename F>
+static void _strdiv(const CCmStrView& s, char delim, F f)
+{
+   size_t find_start = 0;
+   auto find_pos = s.find(delim, find_start);
+   while ( CCmStrView::npos != find_pos )
+   {
+      auto token = s.substr(find_start, find_pos - find_start);
+      if ( ! token.empty() ) 
+      {
+         f(token);
+      }
+
+      find_start = find_pos + 1;
+      find_pos = s.find(delim, find_start);
+   }
+
+   auto token = s.substr(find_start);
+   if ( ! token.empty() ) 
+   {
+      f(token);
+   }
+}
+
+/// \brief parse the leading unsigned integer of the field, false if it is bad
+///
+/// The text after the digits is ignored. A field without digits or out of
+/// range is logged and v is left as it is; the row of it is skipped by the
+/// caller, nothing is thrown.
+template<typename T>
+static bool _parse_uint(const CCmStrView& s, T& v, int base)
+{
+   auto res = cm_from_chars(s.data(), s.end(), v, base);
+   if ( CCmConvErr::ok != res.ec ) 
+   {
+      CM_LOG_WARNING("%s %s number \"%.*s\"!", LOG_HEADER,
+            CCmConvErr::invalid_argument == res.ec ? "invalid" : "out of range", static_cast<int>(s.len), s.ptr);
+   }
+   return CCmConvErr::ok == res.ec;
+}
+
+static bool _parse_u32(const CCmStrView& s, uint32_t& v, int base = 10)
+{
+   return _parse_uint(s, v, base);
+}
+
+static bool _parse_u64(const CCmStrView& s, uint64_t& v, int base = 10)
+{
+   return _parse_uint(s, v, base);
+}
+
+/// \brief parse the decimal digits which fit in INTEGER of sqlite
+///
+/// Nothing but digits is accepted, and the leading zeros are rejected, so the
+/// text of the integer is the same with the original one.
+static bool _try_parse_u64(const CCmStrView& s, uint64_t& v)
+{
+   bool ok = ! s.empty() && s.len <= 18 && ( '0' != s[0] || 1 == s.len );
+   if ( ok )
+   {
+      auto res = cm_from_chars(s.data(), s.end(), v);
+      ok = CCmConvErr::ok == res.ec && s.end() == res.ptr;
+   }
+   return ok;
+}
+
+/// \brief the unsigned integer of the column, loaded directly if it is stored as INTEGER, false if it is empty or bad
+static bool _column_u64(CCmSqlite::statement* s, size_t pos, uint64_t& v)
+{
+   bool ok = true;
+   if ( SQLITE_INTEGER == s->get_type(pos) )
+   {
+      v = static_cast<uint64_t>(s->get_int64(pos));
+   }
+   else
+   {
+      auto txt = s->get_text_view(pos);
+      ok = ! txt.empty() && _parse_u64(txt, v);
+   }
+   return ok;
+}
+
+/// \brief bind the column of a statement to the parameter of the other, in its storage class
+static void _bind_column(CCmSqlite::statement* dst, size_t param, CCmSqlite::statement* src, size_t pos)
+{
+   if ( SQLITE_INTEGER == src->get_type(pos) )
+   {
+      dst->bind_int64(param, src->get_int64(pos));
+   }
+   else
+   {
+      dst->bind_text(param, src->get_text(pos));
+   }
+}
+
+/*!
+ *  \brief  the create table SQL of the schema
+ *
+ *  In the typed one the ID fields are declared without a type, i.e. without
+ *  affinity, so a value is kept in the class it is bound by : the INTEGER
+ *  one as INTEGER, the text one as it is. An INTEGER column would convert
+ *  the text of the leading zeros to INTEGER, and the one over int64 to REAL.
+ */
+template<typename S>
+static std::string _schema_create_sql(bool typed)
+{
+   std::string sql = std::string("create table if not exists ") + S::table + "(";
+   for (size_t i = 0; i < S::FIELD_NUM; ++i)
+   {
+      sql.append(i ? "," : "").append(S::cols[i].name).append((typed && S::cols[i].id) ? " not null" : " text not null");
+      if ( S::cols[i].constraint )
+      {
+         sql.append(" ").append(S::cols[i].constraint);
+      }
+   }
+   return sql + ");";
+}
+
+/// \brief the insert SQL of the schema
+template<typename S>
+static std::string _schema_insert_sql()
+{
+   std::string sql = std::string("insert into ") + S::table + " values(";
+   for (size_t i = 0; i < S::FIELD_NUM; ++i)
+   {
+      sql.append(i ? ",?" : "?");
+   }
+   return sql + ")";
+}
+
+/*!
+ *  \brief  bind the fields [I, FIELD_NUM) of a mid line to the insert statement
+ *
+ *  It is unrolled at compile time, so only the ID fields test the typed
+ *  schema; the empty or not numeric values of them are bound as text.
+ */
+template<typename S, size_t I = 0, bool = (I < static_cast<size_t>(S::FIELD_NUM))>
+struct schema_bind
+{
+   static void bind(CCmSqlite::statement* stmt, const CCmStrView* field, bool typed)
+   {
+      uint64_t id = 0;
+      if ( S::cols[I].id && typed && _try_parse_u64(field[I], id) )
+      {
+         stmt->bind_int64(I + 1, static_cast<int64_t>(id));
+      }
+      else
+      {
+         stmt->bind_text(I + 1, field[I]);
+      }
+      schema_bind<S, I + 1>::bind(stmt, field, typed);
+   }
+};
+
+template<typename S, size_t I>
+struct schema_bind<S, I, false>
+{
+   static void bind(CCmSqlite::statement*, const CCmStrView*, bool) {}
+};
+
+/// \brief the columns of a row selected by "select *" from the table of the schema, by their names
+template<typename S>
+class schema_row
+{
+public:
+   explicit schema_row(CCmSqlite::statement* s) : m_stmt(s) {}
+
+   template<size_t C> CCmStrView text() const { return m_stmt->get_text_view(pos<C>()); }
+   /// \brief false if the column is empty or bad
+   template<size_t C> bool u32(uint32_t& v) const { return _parse_u32(text<C>(), v); }
+   /// \brief false if the column is empty or bad
+   template<size_t C> bool u64(uint64_t& v) const { return _column_u64(m_stmt, pos<C>(), v); }
+   /// \brief true if the column is empty, leaving v as it is, or is good
+   template<size_t C> bool opt_u64(uint64_t& v) const { return ! has<C>() || u64<C>(v); }
+   template<size_t C> bool has() const
+   {
+      return SQLITE_INTEGER == m_stmt->get_type(pos<C>()) || ! m_stmt->get_text_view(pos<C>()).empty();
+   }
+   /// \brief bind the column to the parameter of the other statement, in its storage class
+   template<size_t C> void bind_to(CCmSqlite::statement* dst, size_t param) const { _bind_column(dst, param, m_stmt, pos<C>()); }
+private:
+   template<size_t C> static size_t pos()
+   {
+      static_assert(C < static_cast<size_t>(S::FIELD_NUM), "no such field in the schema");
+      return C;
+   }
+private:
+   CCmSqlite::statement* m_stmt;
+};
+
+/*!
+ *  \brief  tell the kind of the file by its basename
+ *  \param  province the province in the basename, if it is not null
+ *
+ *  The basename is matched against the prefix and the suffix of each rule,
+ *  and what is left between them must be one of the provinces exactly, so
+ *  "CRbeijing" is not taken as "C" of the province "Rbeijing".
+ */
+static bname_kind _bname_kind(const std::string& bname, std::string* province = nullptr)
+{
+   for (const auto& r : g_bname_rule)
+   {
+      const size_t pre = std::strlen(r.prefix), suf = std::strlen(r.suffix);
+      if ( bname.size() < pre + suf || 0 != bname.compare(0, pre, r.prefix)
+         || 0 != bname.compare(bname.size() - suf, suf, r.suffix) )
+      {
+         continue;
+      }
+
+      const size_t len = bname.size() - pre - suf;
+      if ( ! r.province )
+      {
+         if ( 0 == len ) {
+            return r.kind;
+         }
+         continue;
+      }
+      for (const char* e : g_province)
+      {
+         if ( 0 == bname.compare(pre, len, e) )
+         {
+            if ( province ) {
+               *province = e;
+            }
+            return r.kind;
+         }
+      }
+   }
+   return BNAME_NONE;
+}
+
+/// \brief parse the hex number after the leading letter, such as "A00ff", false if it is out of range
+///
+/// It is the same with parsing the text whose leading letter is replaced by
+/// "0x", the text without hex digits is 0.
+static bool _hextou32(const CCmStrView& s, uint32_t& v)
+{
+   bool ok = true;
+   v = 0;
+   if ( s.len > 1 )
+   {
+      auto res = cm_from_chars(s.data() + 1, s.end(), v, 16);
+      ok = CCmConvErr::result_out_of_range != res.ec;
+      if ( ! ok ) 
+      {
+         CM_LOG_WARNING("%s out of range number \"%.*s\"!", LOG_HEADER, static_cast<int>(s.len), s.ptr);
+      }
+      v = ok && CCmConvErr::ok == res.ec ? v : 0;
+   }
+   return ok;
+}
+
+/// \brief match (.+) at pos followed by lit[0], and ngrp - 1 groups more
+///
+/// The longest group is tried first, so the groups are the same with the
+/// greedy regex. The '.' does not match the line terminators.
+static bool _vp_group(const CCmStrView& s, size_t pos, const char* const* lit, size_t ngrp, CCmStrView* grp)
+{
+   size_t n = std::strlen(lit[0]);
+   size_t lim = pos;
+   while ( lim < s.len && '\n' != s[lim] && '\r' != s[lim] ) 
+   {
+      lim++;
+   }
+
+   for (size_t end = lim; end > pos; --end)
+   {
+      if ( end + n <= s.len && 0 == std::memcmp(s.ptr + end, lit[0], n) ) 
+      {
+         bool ok = (1 == ngrp) ? (end + n == s.len) : _vp_group(s, end + n, lit + 1, ngrp - 1, grp + 1);
+         if ( ok ) 
+         {
+            grp[0] = s.substr(pos, end - pos);
+            return true;
+         }
+      }
+   }
+
+   return false;
+}
+
+/// \brief match the whole text as lit[0](.+)lit[1](.+)...lit[ngrp]
+static bool _vp_match(const CCmStrView& s, const char* const* lit, size_t ngrp, CCmStrView* grp)
+{
+   return s.starts_with(lit[0]) && _vp_group(s, std::strlen(lit[0]), lit + 1, ngrp, grp);
+}
+
+/// \brief match \d{1,2} at pos
+static bool _vp_digits(const CCmStrView& s, size_t& pos, int& v)
+{
+   size_t n = 0;
+   v = 0;
+   while ( n < 2 && pos < s.len && s[pos] >= '0' && s[pos] <= '9' ) 
+   {
+      v = v * 10 + (s[pos++] - '0');
+      n++;
+   }
+   return n > 0;
+}
+
+/// \brief match the char c at pos
+static bool _vp_char(const CCmStrView& s, size_t& pos, char c)
+{
+   return pos < s.len && c == s[pos++];
+}
+
+/// \brief match M(\d{1,2})d(\d{1,2})
+static bool _vp_MonthDay(const CCmStrView& s, short int& M, int& d)
+{
+   size_t pos = 0;
+   int a, b;
+   bool ok = _vp_char(s, pos, 'M') && _vp_digits(s, pos, a) && _vp_char(s, pos, 'd') && _vp_digits(s, pos, b) && pos == s.len;
+   if ( ok ) 
+   {
+      M = a;
+      d = b;
+   }
+   return ok;
+}
+
+/// \brief match h(\d{1,2})
+static bool _vp_hour(const CCmStrView& s, int& h)
+{
+   size_t pos = 0;
+   int a;
+   bool ok = _vp_char(s, pos, 'h') && _vp_digits(s, pos, a) && pos == s.len;
+   if ( ok ) 
+   {
+      h = a;
+   }
+   return ok;
+}
+
+/// \brief match h(\d{1,2})m(\d{1,2})
+static bool _vp_HourMinute(const CCmStrView& s, int& h, int& m)
+{
+   size_t pos = 0;
+   int a, b;
+   bool ok = _vp_char(s, pos, 'h') && _vp_digits(s, pos, a) && _vp_char(s, pos, 'm') && _vp_digits(s, pos, b) && pos == s.len;
+   if ( ok ) 
+   {
+      h = a;
+      m = b;
+   }
+   return ok;
+}
+
+/// \brief match (t\d){1,7}
+static bool _vp_WeekDay(const CCmStrView& s)
+{
+   bool ok = s.len >= 2 && s.len <= 14 && 0 == s.len % 2;
+   for (size_t i = 0; ok && i < s.len; i += 2)
+   {
+      ok = 't' == s[i] && s[i + 1] >= '0' && s[i + 1] <= '9';
+   }
+   return ok;
+}
+
+/*!
+ *  \brief  encode the VPeriod text
+ *
+ *  The text is not empty. The unknown text, i.e. type 4, is all 0.
+ */
+static vp_code _vp_encode(const CCmStrView& txtVPeriod)
+{
+   vp_code code = {0, 0, 0};
+   static const char* const lit_type1[] = {"[(", ")(", ")]*[(", ")(", ")]"};
+   static const char* const lit_type2[] = {"[(", ")(", ")]*(", ")"};
+   static const char* const lit_type3[] = {"[(", ")(", ")]"};
+
+   //CM_LOG_INFO("%s VPeriaod \"%s\".", LOG_HEADER, txtVPeriod.c_str());
+   CCmStrView m[4];
+   if ( _vp_match(txtVPeriod, lit_type1, 4, m) ) 
+   {
+      //CM_LOG_INFO("%s type 1 %s.", LOG_HEADER, txtVPeriod.c_str());
+      const auto& Dt1 = m[0];
+      const auto& Dt2 = m[1];
+      const auto& t1  = m[2];
+      const auto& t2  = m[3];
+
+      short int M1, M2;
+      M1 = M2 = 0;                  /* Month */
+
+      static_assert(sizeof(short int) == 2, "short type is not 2 bytes");
+
+      int d1, d2, h1, h2, m1, m2;
+      d1 = d2 = 0;                  /* the day in Month */
+      h1 = h2 = VP_INVALID_HOUR;
+      m1 = m2 = VP_INVALID_MINUTE;
+
+      _vp_MonthDay(Dt1, M1, d1);
+      _vp_MonthDay(Dt2, M2, d2);
+
+      if ( ! _vp_HourMinute(t1, h1, m1) ) 
+      {
+         _vp_hour(t1, h1);
+      }
+
+      if ( ! _vp_HourMinute(t2, h2, m2) ) 
+      {
+         _vp_hour(t2, h2);
+      }
+
+      uint16_t peri16 = 0;
+      peri16 |= M1;
+      peri16 |= M2 << 4;
+
+      uint32_t peri32 = 0;
+      peri32 |= d1;
+      peri32 |= d2 << 5;
+      peri32 |= h1 << 10;
+      peri32 |= h2 << 15;
+      peri32 |= m1 << 20;
+      peri32 |= m2 << 26;
+
+      //CM_LOG_INFO("%s (%d,%d)                 ==> 0x%04x", LOG_HEADER, M1, M2, peri16);
+      //CM_LOG_INFO("%s (%d,%d)-(%d,%d)-(%d,%d) ==> 0x%08x", LOG_HEADER, d1, d2, h1, m1, h2, m2, peri32);
+
+      code.type = 1;
+      code.peri16 = peri16;
+      code.peri32 = peri32;
+   }
+   else if ( _vp_match(txtVPeriod, lit_type2, 3, m) ) 
+   {
+      //CM_LOG_INFO("%s type 2, size %d, %s.", LOG_HEADER, m.size(), txtVPeriod.c_str());
+      const auto& t1      = m[0];
+      const auto& t2      = m[1];
+      const auto& weekday = m[2];
+
+      int h1, h2, m1, m2;
+      h1 = h2 = VP_INVALID_HOUR;
+      m1 = m2 = VP_INVALID_MINUTE;
+
+      if ( ! _vp_hour(t1, h1) ) 
+      {
+         _vp_HourMinute(t1, h1, m1);
+      }
+
+      if ( ! _vp_hour(t2, h2) ) 
+      {
+         _vp_HourMinute(t2, h2, m2);
+      }
+
+      char wd = 0x00;
+      if ( _vp_WeekDay(weekday) ) 
+      {
+         for(size_t i = 1; i < weekday.size(); i += 2 )
+         {
+            switch(weekday[i])
+            {
+               case '1':
+                  wd |= 0x01;
+                  break;
+
+               case '2':
+                  wd |= 0x02;
+                  break;
+
+               case '3':
+                  wd |= 0x04;
+                  break;
+
+               case '4':
+                  wd |= 0x08;
+                  break;
+
+               case '5':
+                  wd |= 0x10;
+                  break;
+
+               case '6':
+                  wd |= 0x20;
+                  break;
+
+               case '7':
+                  wd |= 0x40;
+                  break;
+
+               default:
+                  CM_LOG_INFO("%s unexpected %c.", LOG_HEADER, weekday[i]);
+            }
+         }
+      }
+
+      uint32_t peri32 = 0;
+      peri32 |= wd;
+      peri32 |= h1 << 10;
+      peri32 |= h2 << 15;
+      peri32 |= m1 << 20;
+      peri32 |= m2 << 26;
+
+      //CM_LOG_INFO("%s (%d,%d)-(%d,%d)-(0x%02x) ==> 0x%08x", LOG_HEADER, h1, m1, h2, m2, wd, peri32);
+
+      code.type = 2;
+      code.peri16 = 0;
+      code.peri32 = peri32;
+   }
+   else if( _vp_match(txtVPeriod, lit_type3, 2, m) )
+   {
+      //CM_LOG_INFO("%s type 3 %s.", LOG_HEADER, txtVPeriod.c_str());
+      const auto& t1 = m[0];
+      const auto& t2 = m[1];
+
+      int h1, h2, m1, m2;
+      h1 = h2 = VP_INVALID_HOUR;
+      m1 = m2 = VP_INVALID_MINUTE;
+
+      if ( ! _vp_hour(t1, h1) ) 
+      {
+         _vp_HourMinute(t1, h1, m1);
+      }
+
+      if ( ! _vp_hour(t2, h2) ) 
+      {
+         _vp_HourMinute(t2, h2, m2);
+      }
+
+      uint32_t peri32 = 0;
+      peri32 |= h1 << 10;
+      peri32 |= h2 << 15;
+      peri32 |= m1 << 20;
+      peri32 |= m2 << 26;
+
+      //CM_LOG_INFO("%s (%d,%d)-(%d,%d) ==> 0x%08x", LOG_HEADER, h1, m1, h2, m2, peri32);
+
+      code.type = 3;
+      code.peri16 = 0;
+      code.peri32 = peri32;
+   }
+   else
+   {
+      CM_LOG_INFO("%s type 4 %.*s.", LOG_HEADER, static_cast<int>(txtVPeriod.size()), txtVPeriod.data());
+   }
+   return code;
+}
+
+/// \brief convert the CR row, false if a number of it is bad
+static bool _CR_row2data(
+   row_memo& memo,
+   uint64_t CRID,
+   const CCmStrView& txtVPeriod,
+   const CCmStrView& txtVPDir,
+   const CCmStrView& txtVeh_Type,
+   const CCmStrView& txtVP_Appro,
+   CR_RowData& buf
+)
+{
+   static_assert(sizeof(buf) == 16, "buffer is not 16 bytes;");
+   _bzero(buf);
+
+   buf.CRID = CRID; 
+   //CM_LOG_INFO("%s VPDir \"%s\".", LOG_HEADER, txtVPDir.c_str());
+   uint32_t VPDir = 0;
+   bool ok = _parse_u32(txtVPDir, VPDir);
+   buf.VPDir = VPDir; 
+   //CM_LOG_INFO("%s VP_Approx \"%s\".", LOG_HEADER, txtVP_Appro.c_str());
+   if ( ok && ! txtVP_Appro.empty() ) 
+   {
+      uint32_t approx = 0;
+      ok = _parse_u32(txtVP_Appro, approx);
+      buf.VP_Approx = approx + 1;
+   }
+   else 
+   {
+      buf.VP_Approx = 0;
+   }
+
+   //CM_LOG_INFO("%s Veh_Type \"%s\".", LOG_HEADER, txtVeh_Type.c_str());
+   if ( ok && ! txtVeh_Type.empty() ) 
+   {
+      uint64_t type64 = 0;
+      ok = _parse_u64(txtVeh_Type, type64, 2);
+      buf.Vehcl_Type = static_cast<uint32_t>(type64);
+   }
+   else 
+   {
+      buf.Vehcl_Type = 0;
+   }
+
+   //CM_LOG_INFO("%s VPeriaod \"%s\".", LOG_HEADER, txtVPeriod.c_str());
+   if ( ! txtVPeriod.empty() ) 
+   {
+      const auto& code = memo.vperiod.get(txtVPeriod, _vp_encode);
+      buf.VPeri_Type = code.type;
+      buf.VPeriod16  = code.peri16;
+      buf.VPeriod32  = code.peri32;
+   }
+   else 
+   {
+      buf.VPeri_Type = 0;
+   }
+   return ok;
+}
+
+/// \brief the lane bytes of the pipe list, one lane one byte
+static lane_code _lane_encode(const CCmStrView& txt, int base)
+{
+   lane_code code;
+   code.ok = true;
+   _strdiv(txt, '|', [&](const CCmStrView& e){
+      uint32_t v = 0;
+      code.ok = _parse_u32(e, v, base) && code.ok;
+      code.lane.push_back(static_cast<char>(v));
+   });
+   return code;
+}
+
+/// \brief the lane bytes padded for the lanes
+static size_t _lane_bytes(size_t lane)
+{
+   return (lane + LANE_ALIGN - 1) / LANE_ALIGN * LANE_ALIGN;
+}
+
+/*!
+ *  \brief  convert the Toll ETA row into buf and the lane bytes, which are
+ *          padded to 8 bytes and allocated from the arena.
+ *  \return false if a number of the row is bad
+ */
+static bool _TollETA_row2data(
+      CCmArena& arena,
+      row_memo& memo,
+      uint64_t CondID, 
+      const CCmStrView& txtTollMode,
+      const CCmStrView& txtTollCard,
+      const CCmStrView& txtTollType,
+      TollETA_RowData& buf,
+      CCmStrView& lanes
+)
+{
+   static_assert(sizeof(buf) == 8, "buffer is not 8 bytes;");
+
+   buf.CondID = CondID; 
+   uint32_t type = 0;
+   bool ok = _parse_u32(txtTollType, type);
+   buf.TollType = type;
+
+   // the TollMode and the CardMode share one lane buffer, one lane one byte
+   size_t capacity = txtTollMode.size() + txtTollCard.size() + LANE_ALIGN;
+   char* extbuf = arena.alloc_text(capacity);
+   size_t lane = 0;
+   if ( ! txtTollMode.empty() ) 
+   {
+      const auto& mode = memo.toll_mode.get(txtTollMode, [](const CCmStrView& t){ return _lane_encode(t, 2); });
+      ok = mode.ok && ok;
+      lane = std::copy(mode.lane.begin(), mode.lane.end(), extbuf + lane) - extbuf;
+   }
+
+   if ( ! txtTollCard.empty() ) 
+   {
+      const auto& card = memo.toll_card.get(txtTollCard, [](const CCmStrView& t){ return _lane_encode(t, 10); });
+      ok = card.ok && ok;
+      lane = std::copy(card.lane.begin(), card.lane.end(), extbuf + lane) - extbuf;
+   }
+
+   // the lanes over the extension block too are truncated
+   if ( lane > ETA_LANE_MAX + C_EXT_MAX )
+   {
+      CM_LOG_WARNING("%s Toll ETA CondID %llu, %zu lanes truncated to %zu.", LOG_HEADER,
+         static_cast<unsigned long long>(CondID), lane, ETA_LANE_MAX + C_EXT_MAX);
+      lane = ETA_LANE_MAX + C_EXT_MAX;
+   }
+
+   size_t extsiz = 0;
+   buf.lane_num = std::min(lane, ETA_LANE_MAX);
+   buf.ext_lane = lane - buf.lane_num;
+   if ( lane > 0 ) 
+   {
+      //CM_LOG_INFO("%s type %d, lane number %d", LOG_HEADER, buf.TollType, buf.lane_num);
+      extsiz = _lane_bytes(lane);
+      std::fill(extbuf + lane, extbuf + extsiz, '\0');
+   }
+   else
+   {
+      CM_LOG_WARNING("%s ETA record is something empty!", LOG_HEADER);
+   }
+
+   lanes = CCmStrView(extbuf, extsiz);
+   return ok;
+}
+
+/// \brief convert the Toll Pattern row, false if a number of it is out of range
+static bool _TollPattern_row2data(
+      uint64_t CondID,
+      const CCmStrView& txtPaternNo,
+      const CCmStrView& txtArrowNo,
+      TollPattern_RowData& buf
+)
+{
+   static_assert(sizeof(buf) == 16, "buffer is not 16 bytes;");
+
+   // the leading letter of the numbers is taken as "0x"
+   buf.CondID = CondID; 
+   uint32_t ptn = 0, arrow = 0;
+   bool ok = _hextou32(txtPaternNo, ptn) && _hextou32(txtArrowNo, arrow);
+   buf.PatterNo = ptn; 
+   buf.ArrowNo = arrow; 
+
+   return ok;
+}
+
+/// \brief write the CR row by its layout
+template<typename O>
+static void _CR_write(O& os, const CR_RowData& r)
+{
+   typedef CR_Layout L;
+   CCmWords<2> w = {};
+   w.put<L::CRID>(r.CRID);
+   w.put<L::VPDir>(r.VPDir);
+   w.put<L::VP_Approx>(r.VP_Approx);
+   w.put<L::VPeri_Type>(r.VPeri_Type);
+   w.put<L::VPeriod16>(r.VPeriod16);
+   w.put<L::VPeriod32>(r.VPeriod32);
+   w.put<L::Vehcl_Type>(r.Vehcl_Type);
+   _write_words(os, w);
+}
+
+/// \brief write the Toll ETA row by its layout, the lanes of lane_num and ext_lane follow it padded to 8 bytes
+template<typename O>
+static void _TollETA_write(O& os, const TollETA_RowData& r, const CCmStrView& lanes)
+{
+   typedef TollETA_Layout L;
+   CCmWords<1> w = {};
+   w.put<L::CondID>(r.CondID);
+   w.put<L::TollType>(r.TollType);
+   w.put<L::lane_num>(r.lane_num);
+   w.put<L::ext_lane>(r.ext_lane);
+   _write_words(os, w);
+
+   const size_t n = r.lane_num + r.ext_lane;
+   const char zero[LANE_ALIGN] = {0};
+   os.write(lanes.data(), n);
+   os.write(zero, _lane_bytes(n) - n);
+}
+
+/// \brief write the Toll pattern row by its layout
+template<typename O>
+static void _TollPattern_write(O& os, const TollPattern_RowData& r)
+{
+   typedef TollPattern_Layout L;
+   CCmWords<2> w = {};
+   w.put<L::CondID>(r.CondID);
+   w.put<L::PatterNo>(r.PatterNo);
+   w.put<L::ArrowNo>(r.ArrowNo);
+   _write_words(os, w);
+}
+
+/*!
+ *  \brief  start the C-CR-Toll record by the fields of C
+ *
+ *  The link IDs are 0 if they are absent.
+ */
+static void _C_record_begin(
+   C_CR_Toll_Record& rec,
+   bool hasInLinkId, uint64_t InLinkId,
+   bool hasOutLinkId, uint64_t OutLinkId,
+   uint64_t CondType
+)
+{
+   _bzero(rec.header);
+   _bzero(rec.eta);
+   _bzero(rec.pattern);
+   rec.cr.clear();
+   rec.lane.clear();
+
+   // condition type
+   rec.header.CondType = static_cast<uint32_t>(CondType) - 1;
+   // inlink ID
+   if ( hasInLinkId ) {
+      rec.header.InLinkId = InLinkId;
+   }
+   // outlink ID
+   if ( hasOutLinkId ) {
+      rec.header.OutLinkId = OutLinkId;
+   }
+}
+
+/// \brief set the index of the VPeriod slot entry of the block
+void C_VPSlots::refer(C_CRBlock& b)
+{
+   uint64_t key = static_cast<uint64_t>(b.VPeri_Type) << 48 | static_cast<uint64_t>(b.VPeriod16) << 32 | b.VPeriod32;
+   auto it = code.find(key);
+   uint16_t idx = ( code.end() != it ) ? it->second : add(b);
+   if ( code.end() == it ) {
+      code.emplace(key, idx);
+   }
+   b.slot = idx;
+   refs++;
+}
+
+/// \brief the index of the entry of the block, which is added if it is new
+uint16_t C_VPSlots::add(const C_CRBlock& b)
+{
+   entry e;
+   _bzero(e);
+   uint32_t p16 = b.VPeriod16, p32 = b.VPeriod32;
+   uint32_t weekday = 0x7F;
+   switch(b.VPeri_Type)
+   {
+      case 1:
+         e.M1 = p16 & 0x0F;
+         e.M2 = (p16 >> 4) & 0x0F;
+         e.d1 = p32 & 0x1F;
+         e.d2 = (p32 >> 5) & 0x1F;
+         break;
+
+      case 2:
+         weekday = p32 & 0x7F;
+         break;
+
+      default:
+         break;
+   }
+
+   // the minutes of the day, the whole day if the hours are not available
+   uint32_t start = 0, end = 24 * 60;
+   uint32_t h1 = (p32 >> 10) & 0x1F, h2 = (p32 >> 15) & 0x1F;
+   uint32_t m1 = (p32 >> 20) & 0x3F, m2 = (p32 >> 26) & 0x3F;
+   if ( b.VPeri_Type >= 1 && b.VPeri_Type <= 3 && h1 < VP_INVALID_HOUR && h2 < VP_INVALID_HOUR )
+   {
+      start = h1 * 60 + (m1 < VP_INVALID_MINUTE ? m1 : 0);
+      end = h2 * 60 + (m2 < VP_INVALID_MINUTE ? m2 : 0);
+      if ( end < start ) {
+         end += 24 * 60;                  // over the midnight, into the next day
+      }
+      else if ( end == start ) {
+         start = 0;
+         end = 24 * 60;
+      }
+   }
+
+   // a slot is set if the period covers any part of it
+   const uint32_t slot_len = 24 * 60 / slots;
+   for (size_t d = 0; d < days; ++d)
+   {
+      if ( weekday & (1u << d) )
+      {
+         for (uint32_t k = start / slot_len; k < (end + slot_len - 1) / slot_len; ++k)
+         {
+            size_t bit = ((d + k / slots) % days) * slots + k % slots;
+            e.bitmap[bit / 8] |= 1 << (bit % 8);
+         }
+      }
+   }
+
+   std::string key(reinterpret_cast<const char*>(&e), sizeof(e));
+   auto it = index.find(key);
+   if ( index.end() != it ) {
+      return it->second;
+   }
+   if ( table.size() >= none ) {
+      return none;
+   }
+   uint16_t idx = static_cast<uint16_t>(table.size());
+   index.emplace(std::move(key), idx);
+   table.push_back(e);
+   return idx;
+}
+
+/// \brief add the record as the next ordinal to the classes of its CRs
+void C_VehIndex::add(const C_CR_Toll_Record& rec)
+{
+   uint32_t mask = 0;
+   for (const auto& b : rec.cr)
+   {
+      mask |= b.Vehcl_Type;
+   }
+   for (size_t b = 0; b < classes; ++b)
+   {
+      if ( mask & (1u << b) ) {
+         ord[b].push_back(next);
+      }
+   }
+   next++;
+}
+
+/*!
+ *  \brief  the bytes of the index, padded to 16 bytes
+ *
+ *  A head {class number, byte size, record number, 0}, the directory of
+ *  {byte offset, cardinality} of the classes, and the bitmaps of the classes
+ *  not empty. A bitmap is {container number, 0} and the descriptors {key,
+ *  cardinality - 1, byte offset} of the containers, then the containers,
+ *  each padded to 8 bytes. The offsets of a bitmap are from its start, the
+ *  others from the start of the index.
+ */
+std::string C_VehIndex::serialize(bool big) const
+{
+   auto put32 = [big](std::string& s, uint32_t v){
+      v = _ord(v, big);
+      s.append(reinterpret_cast<const char*>(&v), sizeof(v));
+   };
+   auto put16 = [big](std::string& s, uint16_t v){
+      v = _ord(v, big);
+      s.append(reinterpret_cast<const char*>(&v), sizeof(v));
+   };
+   auto pad = [](std::string& s, size_t n){
+      s.append((n - s.size() % n) % n, '\0');
+   };
+
+   std::string out(16 + 8 * classes, '\0');
+   for (size_t b = 0; b < classes; ++b)
+   {
+      const auto& v = ord[b];
+      if ( v.empty() ) {
+         continue;
+      }
+
+      // the containers, as the ranges of the ordinals of the same high 16 bits
+      std::vector<std::pair<size_t, size_t>> cont;
+      for (size_t i = 0; i < v.size(); )
+      {
+         size_t j = i;
+         while ( j < v.size() && (v[j] >> 16) == (v[i] >> 16) ) {
+            j++;
+         }
+         cont.push_back(std::make_pair(i, j));
+         i = j;
+      }
+
+      std::string bmp;
+      put32(bmp, static_cast<uint32_t>(cont.size()));
+      put32(bmp, 0);
+      std::string data;
+      size_t data_start = bmp.size() + 8 * cont.size();
+      for (const auto& c : cont)
+      {
+         size_t card = c.second - c.first;
+         put16(bmp, static_cast<uint16_t>(v[c.first] >> 16));
+         put16(bmp, static_cast<uint16_t>(card - 1));
+         put32(bmp, static_cast<uint32_t>(data_start + data.size()));
+         if ( card > array_max ) {
+            std::string bits(65536 / 8, '\0');
+            for (size_t i = c.first; i < c.second; ++i) {
+               bits[(v[i] & 0xFFFF) / 8] |= static_cast<char>(1 << (v[i] % 8));
+            }
+            data += bits;
+         }
+         else {
+            for (size_t i = c.first; i < c.second; ++i) {
+               put16(data, static_cast<uint16_t>(v[i] & 0xFFFF));
+            }
+         }
+         pad(data, 8);
+      }
+      bmp += data;
+      pad(bmp, 16);
+
+      uint32_t dir[2] = {_ord(static_cast<uint32_t>(out.size()), big), _ord(static_cast<uint32_t>(v.size()), big)};
+      std::memcpy(&out[16 + 8 * b], dir, sizeof(dir));
+      out += bmp;
+   }
+
+   uint32_t head[4] = {_ord(static_cast<uint32_t>(classes), big), _ord(static_cast<uint32_t>(out.size()), big), _ord(next, big), 0};
+   std::memcpy(&out[0], head, sizeof(head));
+   return out;
+}
+
+static void _C_record_add_CR(C_CR_Toll_Record& rec, const CR_RowData& row)
+{
+   C_CRBlock buf;
+   _bzero(buf);
+   buf.VPDir      = row.VPDir;
+   buf.VP_Approx  = row.VP_Approx;
+   buf.VPeri_Type = row.VPeri_Type;
+   buf.VPeriod16  = row.VPeriod16;
+   buf.VPeriod32  = row.VPeriod32;
+   buf.Vehcl_Type = row.Vehcl_Type;
+   rec.cr.push_back(buf);
+}
+
+/// \brief the CRs kept of a record, with the ones of the extension block if overflow
+static size_t _C_CR_limit(bool overflow)
+{
+   return C_CR_MAX + (overflow ? C_EXT_MAX : 0);
+}
+
+/*!
+ *  \brief  count the CRs into the header, only C_CR_MAX of them are kept
+ *
+ *  With the overflow, the CRs over C_CR_MAX are kept for the extension block,
+ *  up to C_EXT_MAX of them.
+ */
+static size_t _C_record_end_CR(C_CR_Toll_Record& rec)
+{
+   rec.cr.resize(std::min(rec.cr.size(), _C_CR_limit(rec.overflow)));
+   rec.header.cnt_CRID = std::min(rec.cr.size(), C_CR_MAX);
+   return rec.header.cnt_CRID;
+}
+
+/*!
+ *  \brief  set the ETA block, which is dropped if the lanes don't fit in it
+ *
+ *  With the overflow, the block is filled with the first 15 lanes instead,
+ *  and the lanes after them are kept for the extension block.
+ */
+static bool _C_record_set_ETA(C_CR_Toll_Record& rec, const TollETA_RowData& row, const CCmStrView& lane)
+{
+   bool ok = lane.size() <= sizeof(rec.eta.laneinfo);
+   if ( ok ) {
+      rec.eta.ETA_type = row.TollType;
+      rec.eta.lane_num = row.lane_num;
+      std::copy(lane.begin(), lane.end(), rec.eta.laneinfo);
+      rec.header.ETA_flag = 1;
+   }
+   else if ( rec.overflow ) {
+      const size_t in = row.lane_num;
+      rec.eta.ETA_type = row.TollType;
+      rec.eta.lane_num = in;
+      std::copy_n(lane.begin(), in, rec.eta.laneinfo);
+      rec.lane.assign(lane.begin() + in, lane.begin() + in + row.ext_lane);
+      rec.header.ETA_flag = 1;
+      ok = true;
+   }
+   return ok;
+}
+
+static void _C_record_set_pattern(C_CR_Toll_Record& rec, const TollPattern_RowData& row)
+{
+   rec.pattern.PatterNo = row.PatterNo;
+   rec.pattern.ArrowNo  = row.ArrowNo;
+   rec.header.ptn_flag = 1;
+}
+
+/// \brief the words of the record header by its layout
+static CCmWords<2> _C_header_words(const C_RecHeader& h)
+{
+   typedef C_RecHeader_Layout L;
+   CCmWords<2> w = {};
+   w.put<L::InLinkId>(h.InLinkId);
+   w.put<L::OutLinkId_lo>(h.OutLinkId);
+   w.put<L::OutLinkId_hi>(h.OutLinkId >> 24);
+   w.put<L::CondType>(h.CondType);
+   w.put<L::cnt_CRID>(h.cnt_CRID);
+   w.put<L::ETA_flag>(h.ETA_flag);
+   w.put<L::ptn_flag>(h.ptn_flag);
+   w.put<L::cr_dict>(h.cr_dict);
+   w.put<L::ext_flag>(h.ext_flag);
+   return w;
+}
+
+static void _C_header_of(const CCmWords<2>& w, C_RecHeader& h)
+{
+   typedef C_RecHeader_Layout L;
+   _bzero(h);
+   h.InLinkId  = w.get<L::InLinkId>();
+   h.OutLinkId = w.get<L::OutLinkId_lo>() | w.get<L::OutLinkId_hi>() << 24;
+   h.CondType  = w.get<L::CondType>();
+   h.cnt_CRID  = w.get<L::cnt_CRID>();
+   h.ETA_flag  = w.get<L::ETA_flag>();
+   h.ptn_flag  = w.get<L::ptn_flag>();
+   h.cr_dict   = w.get<L::cr_dict>();
+   h.ext_flag  = w.get<L::ext_flag>();
+}
+
+/// \brief the words of the CR block by its layout
+static CCmWords<2> _C_CR_words(const C_CRBlock& b)
+{
+   typedef C_CRBlock_Layout L;
+   CCmWords<2> w = {};
+   w.put<L::VPDir>(b.VPDir);
+   w.put<L::VP_Approx>(b.VP_Approx);
+   w.put<L::VPeri_Type>(b.VPeri_Type);
+   w.put<L::slot>(b.slot);
+   w.put<L::VPeriod16>(b.VPeriod16);
+   w.put<L::VPeriod32>(b.VPeriod32);
+   w.put<L::Vehcl_Type>(b.Vehcl_Type);
+   return w;
+}
+
+static void _C_CR_of(const CCmWords<2>& w, C_CRBlock& b)
+{
+   typedef C_CRBlock_Layout L;
+   _bzero(b);
+   b.VPDir      = w.get<L::VPDir>();
+   b.VP_Approx  = w.get<L::VP_Approx>();
+   b.VPeri_Type = w.get<L::VPeri_Type>();
+   b.slot       = w.get<L::slot>();
+   b.VPeriod16  = w.get<L::VPeriod16>();
+   b.VPeriod32  = w.get<L::VPeriod32>();
+   b.Vehcl_Type = w.get<L::Vehcl_Type>();
+}
+
+/// \brief the words of the Toll pattern block by its layout
+static CCmWords<2> _C_pattern_words(const C_TollPatternBlock& b)
+{
+   typedef C_TollPattern_Layout L;
+   CCmWords<2> w = {};
+   w.put<L::PatterNo>(b.PatterNo);
+   w.put<L::ArrowNo>(b.ArrowNo);
+   return w;
+}
+
+static void _C_pattern_of(const CCmWords<2>& w, C_TollPatternBlock& b)
+{
+   typedef C_TollPattern_Layout L;
+   _bzero(b);
+   b.PatterNo = w.get<L::PatterNo>();
+   b.ArrowNo  = w.get<L::ArrowNo>();
+}
+
+/// \brief the bytes of the Toll ETA block, the types in the first byte and the lanes
+static void _C_eta_bytes(const C_TollETABlock& b, char (&buf)[16])
+{
+   buf[0] = static_cast<char>((b.ETA_type & 0x0F) | (b.lane_num & 0x0F) << 4);
+   std::copy_n(b.laneinfo, sizeof(b.laneinfo), buf + 1);
+}
+
+static void _C_eta_of(const char* p, C_TollETABlock& b)
+{
+   _bzero(b);
+   b.ETA_type = p[0] & 0x0F;
+   b.lane_num = (p[0] >> 4) & 0x0F;
+   std::copy_n(p + 1, sizeof(b.laneinfo), b.laneinfo);
+}
+
+/// \brief write the bytes padded to 16 bytes, return the padded size
+template<typename O>
+static size_t _write_padded(O& os, const void* p, size_t n)
+{
+   static const char zero[16] = {0};
+   const size_t pad = (16 - n % 16) % 16;
+   os.write(p, n);
+   if ( pad > 0 ) {
+      os.write(zero, pad);
+   }
+   return n + pad;
+}
+
+/*!
+ *  \brief  write the record, return the written bytes
+ *
+ *  With the dictionary, the CRs are written as their indexes padded to 16
+ *  bytes, unless the dictionary is full. With the slot table, the CRs refer
+ *  to the slots of their VPeriods first. The record is the next ordinal of
+ *  the vehicle class index.
+ *
+ *  With the overflow, the CRs over cnt_CRID and the lanes over the ETA block
+ *  follow the CRs in the extension block, flagged by ext_flag : a head of 16
+ *  bytes {CR number, lane number}, the CRs in the same form as the ones of
+ *  the record, and the lanes padded to 16 bytes.
+ */
+template<typename O>
+static size_t _C_record_write(O& os, C_CR_Toll_Record& rec, C_RecTables* tabs)
+{
+   uint16_t idx[16] = {0};
+   const size_t cnt = rec.header.cnt_CRID;
+   const size_t all = rec.cr.size();
+   C_CRDict* dict = tabs ? tabs->dict : nullptr;
+   for (size_t i = 0; tabs && tabs->slots && i < all; ++i)
+   {
+      tabs->slots->refer(rec.cr[i]);
+   }
+   if ( tabs && tabs->veh ) {
+      tabs->veh->add(rec);
+   }
+   bool by_dict = nullptr != dict && cnt > 0;
+   rec.idx.clear();
+   for (size_t i = 0; by_dict && i < all; ++i)
+   {
+      uint16_t n = 0;
+      by_dict = dict->find(rec.cr[i], n);
+      if ( i < cnt ) {
+         idx[i] = _ord(n, os.big_endian());
+      }
+      else {
+         rec.idx.push_back(_ord(n, os.big_endian()));
+      }
+   }
+   rec.header.cr_dict = by_dict;
+   rec.header.ext_flag = all > cnt || ! rec.lane.empty();
+
+   size_t size = sizeof(rec.header);
+   _write_words(os, _C_header_words(rec.header));
+
+   if ( rec.header.ETA_flag ) {
+      char eta[sizeof(rec.eta)];
+      _C_eta_bytes(rec.eta, eta);
+      os.write(eta, sizeof(eta));
+      size += sizeof(rec.eta);
+   }
+
+   if ( rec.header.ptn_flag ) {
+      _write_words(os, _C_pattern_words(rec.pattern));
+      size += sizeof(rec.pattern);
+   }
+
+   if ( by_dict ) {
+      size_t idxsiz = (sizeof(idx[0]) * cnt + 15) / 16 * 16;
+      os.write(idx, idxsiz);
+      size += idxsiz;
+      dict->refs += cnt;
+   }
+   else {
+      for(size_t i = 0; i < cnt; ++i)
+      {
+         _write_words(os, _C_CR_words(rec.cr[i]));
+         size += sizeof(rec.cr[i]);
+      }
+   }
+
+   if ( rec.header.ext_flag ) {
+      typedef C_RecExt_Layout L;
+      CCmWords<2> w = {};
+      w.put<L::cnt_CRID>(all - cnt);
+      w.put<L::lane_num>(rec.lane.size());
+      _write_words(os, w);
+      size += sizeof(w);
+
+      if ( by_dict ) {
+         size += rec.idx.empty() ? 0 : _write_padded(os, rec.idx.data(), sizeof(rec.idx[0]) * rec.idx.size());
+         dict->refs += rec.idx.size();
+      }
+      else {
+         for(size_t i = cnt; i < all; ++i)
+         {
+            _write_words(os, _C_CR_words(rec.cr[i]));
+            size += sizeof(rec.cr[i]);
+         }
+      }
+      size += rec.lane.empty() ? 0 : _write_padded(os, rec.lane.data(), rec.lane.size());
+   }
+
+   return size;
+}
+
+/// \brief read back the record written without the dictionary, with the extension block if any, return its bytes
+static size_t _C_record_read(const char* p, C_CR_Toll_Record& rec, bool big)
+{
+   size_t size = sizeof(rec.header);
+   _C_header_of(_read_words<2>(p, big), rec.header);
+   if ( rec.header.ETA_flag ) {
+      _C_eta_of(p + size, rec.eta);
+      size += sizeof(rec.eta);
+   }
+   if ( rec.header.ptn_flag ) {
+      _C_pattern_of(_read_words<2>(p + size, big), rec.pattern);
+      size += sizeof(rec.pattern);
+   }
+   rec.cr.resize(rec.header.cnt_CRID);
+   for (auto& e : rec.cr)
+   {
+      _C_CR_of(_read_words<2>(p + size, big), e);
+      size += sizeof(e);
+   }
+   rec.lane.clear();
+   if ( rec.header.ext_flag ) {
+      typedef C_RecExt_Layout L;
+      auto w = _read_words<2>(p + size, big);
+      size += sizeof(w);
+      const size_t cnt = rec.cr.size();
+      rec.cr.resize(cnt + w.get<L::cnt_CRID>());
+      for (size_t i = cnt; i < rec.cr.size(); ++i)
+      {
+         _C_CR_of(_read_words<2>(p + size, big), rec.cr[i]);
+         size += sizeof(rec.cr[i]);
+      }
+      rec.lane.assign(p + size, w.get<L::lane_num>());
+      size += (rec.lane.size() + 15) / 16 * 16;
+   }
+   return size;
+}
+
+/// \brief write the dictionary after the records
+static void _C_CR_dict_write(CCmBinWriter& os, const C_CRDict& dict)
+{
+   CM_LOG_INFO("%s CR dictionary %zu blocks for %zu CRs.", LOG_HEADER, dict.block.size(), dict.refs);
+   for (const auto& b : dict.block)
+   {
+      _write_words(os, _C_CR_words(b));
+   }
+}
+
+/// \brief write the VPeriod slot table after the dictionary, a head {entry number, entry size, 0, 0} and the entries
+static void _C_VP_slots_write(CCmBinWriter& os, const C_VPSlots& slots)
+{
+   CM_LOG_INFO("%s VPeriod slot table %zu entries for %zu CRs.", LOG_HEADER, slots.table.size(), slots.refs);
+   const bool big = os.big_endian();
+   const uint32_t head[4] = {_ord(static_cast<uint32_t>(slots.table.size()), big), _ord(static_cast<uint32_t>(sizeof(C_VPSlots::entry)), big), 0, 0};
+   os.write(head, sizeof(head));
+   os.write(slots.table.data(), slots.table.size() * sizeof(C_VPSlots::entry));
+}
+
+/// \brief write the shared tables after the records in order : the dictionary, the slot table and the vehicle class index
+static void _C_tables_write(CCmBinWriter& os, const C_RecTables& tabs)
+{
+   if ( tabs.dict ) {
+      _C_CR_dict_write(os, *tabs.dict);
+   }
+   if ( tabs.slots ) {
+      _C_VP_slots_write(os, *tabs.slots);
+   }
+   if ( tabs.veh ) {
+      auto idx = tabs.veh->serialize(os.big_endian());
+      CM_LOG_INFO("%s vehicle class index %zu bytes for %u records.", LOG_HEADER, idx.size(), tabs.veh->next);
+      os.write(idx.data(), idx.size());
+   }
+}
+
+/*!
+ *  \brief  write the header of the C-CR-Toll bin at its start
+ *
+ *  The records are written first after a place holder of the header, as the
+ *  record number and the data size are known at last. The data size is of
+ *  the records only, the dictionary, if any, follows them.
+ */
+static bool _C_CR_Toll_header(CCmBinWriter& os, uint64_t bin_start, uint32_t row_num, size_t bin_size,
+   const C_RecTables& tabs, bool tiled, bool overflow)
+{
+   uint32_t datasize = bin_size / 16;
+   uint32_t dirtsize = bin_size % 16;
+   CM_LOG_INFO("%s All stepped rows number is %d, data size %d, dirty data %d.", LOG_HEADER,
+      row_num, datasize, dirtsize);
+
+   const uint32_t flags = (tabs.dict ? C_CR_TOLL_FLAG_DICT : 0) | (tiled ? C_CR_TOLL_FLAG_TILE : 0)
+      | (tabs.slots ? C_CR_TOLL_FLAG_SLOT : 0) | (tabs.veh ? C_CR_TOLL_FLAG_VEH : 0)
+      | (overflow ? C_CR_TOLL_FLAG_EXT : 0);
+   const uint32_t dictnum = tabs.dict ? tabs.dict->block.size() : 0;
+   struct alignas(16){
+      uint32_t recnum;
+      uint32_t datsiz;
+      uint32_t flags;
+      uint32_t dictnum;
+   }header = {_ord(row_num, os.big_endian()), _ord(datasize, os.big_endian()), _ord(flags, os.big_endian()), _ord(dictnum, os.big_endian())};
+
+   static_assert(sizeof(header) == 16, "header is not 16 bytes!");
+
+   os.patch(bin_start, &header, sizeof(header));
+
+   return os.good();
+}
+
+/// \brief copy the record read from the buffer, by the shared tables if any, return its bytes in the bin
+static size_t _C_record_copy(CCmBinWriter& os, const char* p, size_t n, C_CR_Toll_Record& rec, C_RecTables* tabs)
+{
+   if ( nullptr == tabs ) {
+      os.write(p, n);
+      return n;
+   }
+   _C_record_read(p, rec, os.big_endian());
+   return _C_record_write(os, rec, tabs);
+}
+
+/// \brief move the records marked in the buffer into the sort by MapID
+static void _tiles_add(CCmSpill& tiles, CCmRangeOut& out)
+{
+   const auto& mark = out.mark;
+   for (size_t k = 0; k < mark.size(); ++k)
+   {
+      size_t end = (k + 1 < mark.size()) ? mark[k + 1].second : out.buf.size();
+      tiles.add(mark[k].first, out.buf.data() + mark[k].second, end - mark[k].second);
+   }
+   out.buf.clear();
+   out.mark.clear();
+}
+
+/*!
+ *  \brief  write the records of the sort grouped by MapID, after the tile directory
+ *
+ *  The directory is a head of 16 bytes {"MTIL", tile number, 0, 0} and the
+ *  entries of 16 bytes {MapID, record number, byte offset in the bin} in the
+ *  ascending order of MapID, ended by an entry of the offset after all the
+ *  records. The records of a mesh keep their order, and are written by
+ *  put(p, n). The entries are patched at last, as the dictionary may change
+ *  the bytes of the records on the way.
+ */
+static bool _tiles_write(CCmBinWriter& bin, CCmSpill& rec, const std::function<void(const char*, size_t)>& put)
+{
+   struct tile_entry
+   {
+      uint32_t mapid;
+      uint32_t recnum;
+      uint64_t offset;
+   };
+   static_assert(sizeof(tile_entry) == 16, "tile entry is not 16 bytes!");
+   std::vector<tile_entry> dir;
+   for (const auto& e : rec.keys())
+   {
+      tile_entry t = {e.first, static_cast<uint32_t>(e.second), 0};
+      dir.push_back(t);
+   }
+
+   const bool big = bin.big_endian();
+   const uint32_t head[4] = {_ord(TILE_MAGIC, big), _ord(static_cast<uint32_t>(dir.size()), big), 0, 0};
+   const tile_entry zero = {0, 0, 0};
+   bin.write(head, sizeof(head));
+   auto dir_start = bin.tell();
+   for (size_t i = 0; i <= dir.size(); ++i)
+   {
+      bin.write(&zero, sizeof(zero));
+   }
+
+   size_t t = 0, n = 0;
+   bool ok = rec.merge([&](uint32_t, const char* p, size_t size){
+      if ( 0 == n ) {
+         dir[t].offset = bin.tell();
+      }
+      put(p, size);
+      if ( ++n == dir[t].recnum ) {
+         t++;
+         n = 0;
+      }
+   });
+   tile_entry end = {0, 0, bin.tell()};
+   dir.push_back(end);
+   for (auto& e : dir)
+   {
+      e.mapid = _ord(e.mapid, big);
+      e.recnum = _ord(e.recnum, big);
+      e.offset = _ord(e.offset, big);
+   }
+   bin.patch(dir_start, dir.data(), dir.size() * sizeof(dir[0]));
+   CM_LOG_INFO("%s %zu records in %zu tiles.", LOG_HEADER, rec.size(), dir.size() - 1);
+
+   return ok && bin.good();
+}
+
+/// \brief encode the CR rows of the statement
+static void _scan_CR(CCmSqlite&, CCmSqlite::statement* sel, CCmRangeOut& out)
+{
+   CCmArena arena;
+   row_batch batch(TABLE_CR);
+   row_memo memo;
+   typedef schema_CR S;
+   schema_row<S> row(sel);
+   while(sel->step_row())
+   {
+      uint64_t CRID = 0;
+      CR_RowData buf;
+      if ( ! row.u64<S::CRID>(CRID) || ! _CR_row2data(memo, CRID, row.text<S::VPeriod>(), row.text<S::VPDir>(),
+         row.text<S::Vehcl_Type>(), row.text<S::VP_Approx>(), buf) )
+      {
+         batch.skip(arena);
+         continue;
+      }
+      _CR_write(out, buf);
+      out.rows++;
+      batch.row(arena);
+   }
+   batch.report(arena);
+   memo.report();
+}
+
+/*!
+ *  \brief  encode the Toll ETA rows of the statement
+ *
+ *  The lanes over ETA_LANE_MAX are written after them by ext_lane with the
+ *  overflow, or truncated and counted without it.
+ */
+static void _scan_Toll_ETA(CCmSqlite&, CCmSqlite::statement* sel, CCmRangeOut& out, bool overflow)
+{
+   size_t truncated = 0;
+   CCmArena arena;
+   row_batch batch(TABLE_Toll_ETA);
+   row_memo memo;
+   typedef schema_Toll_ETA S;
+   schema_row<S> row(sel);
+   while(sel->step_row())
+   {
+      uint64_t CondID = 0;
+      TollETA_RowData buf;
+      CCmStrView extbuf;
+      if ( ! row.u64<S::CondId>(CondID) || ! _TollETA_row2data(arena, memo, CondID, row.text<S::TollMode>(),
+         row.text<S::CardMode>(), row.text<S::TollType>(), buf, extbuf) )
+      {
+         batch.skip(arena);
+         continue;
+      }
+      if ( ! overflow && buf.ext_lane > 0 )
+      {
+         buf.ext_lane = 0;
+         truncated++;
+      }
+
+      _TollETA_write(out, buf, extbuf);
+      out.rows++;
+      batch.row(arena);
+   }
+   batch.report(arena);
+   memo.report();
+   if ( truncated > 0 )
+   {
+      CM_LOG_WARNING("%s %zu Toll ETA rows of the lanes over %zu truncated, --overflow keeps them.",
+         LOG_HEADER, truncated, ETA_LANE_MAX);
+   }
+}
+
+/// \brief encode the Toll pattern rows of the statement
+static void _scan_Toll_Pattern(CCmSqlite&, CCmSqlite::statement* sel, CCmRangeOut& out)
+{
+   CCmArena arena;
+   row_batch batch(TABLE_Toll_Pattern);
+   typedef schema_Toll_Pattern S;
+   schema_row<S> row(sel);
+   while(sel->step_row())
+   {
+      uint64_t CondID = 0;
+      TollPattern_RowData buf;
+      if ( ! row.u64<S::CondId>(CondID) || ! _TollPattern_row2data(CondID, row.text<S::Pattern>(), row.text<S::ArrowNo>(), buf) )
+      {
+         batch.skip(arena);
+         continue;
+      }
+
+      _TollPattern_write(out, buf);
+      out.rows++;
+      batch.row(arena);
+   }
+   batch.report(arena);
+}
+
+/// \brief encode the HighWay Junction rows of the statement
+static void _scan_HW_Junction(CCmSqlite&, CCmSqlite::statement* sel, CCmRangeOut& out)
+{
+   CCmArena arena;
+   row_batch batch(TABLE_HW_Junction);
+   typedef schema_HW_Junction S;
+   schema_row<S> row(sel);
+   while(sel->step_row())
+   {
+      uint64_t ID = 0, NodeID = 0, inLinkID = 0, outLinkID = 0;
+      uint32_t AccessType = 0, Attr = 0, MapID = 0;
+      bool ok = row.u64<S::ID>(ID) && row.u64<S::NodeID>(NodeID) && row.u64<S::inLinkID>(inLinkID)
+         && row.u64<S::outLinkID>(outLinkID) && row.u32<S::AccessType>(AccessType) && row.u32<S::Attr>(Attr)
+         && ( ! out.tiled || row.u32<S::MapID>(MapID) );
+      auto txtEst_Item    = row.text<S::Estab_Item>();
+
+      uint32_t Estab_item = 0;
+      char delim = '|';
+      if ( ok && ! txtEst_Item.empty() ) 
+      {
+         unsigned char b = 0;
+         unsigned char gaso = 0;
+         _strdiv(txtEst_Item, delim, [&](const CCmStrView& e)
+         {
+            uint32_t item = 0;
+            if ( ! _parse_u32(e, item) )
+            {
+               ok = false;
+               return;
+            }
+            switch(item)
+            {
+               case 1:
+               b |= 0x01;                 /* restaurant */
+               break;
+
+               case 2:
+               b |= 0x02;                 /* shop */
+               break;
+
+               case 3:
+               b |= 0x04;                 /* inn */
+               break;
+
+               case 4:
+               b |= 0x08;                 /* pub toilet */
+               break;
+
+               case 21:
+               gaso = 1;                  /* PetreChina */
+               break;
+
+               case 22:
+               gaso = 2;                  /* sinopec */
+               break;
+
+               case 23:
+               gaso = 3;                  /* shell */
+               break;
+
+               case 24:
+               gaso = 4;                  /* Mobil */
+               break;
+
+               case 25:
+               gaso = 5;                  /* British Petroleum */
+               break;
+
+               case 26:
+               gaso = 0x0f;               /* Other */
+               break;
+
+               default:
+               CM_LOG_WARNING("%s not expect the Estab_item %d", LOG_HEADER, item);
+            }
+         });
+
+         if ( b ) 
+         {
+            Estab_item |= b;
+         }
+         if ( gaso ) 
+         {
+            Estab_item |= gaso << 4;
+         }
+      }
+      if ( ! ok )
+      {
+         batch.skip(arena);
+         continue;
+      }
+
+      // the inLinkID is split by the words
+      typedef HW_Junction_Layout L;
+      CCmWords<3> w = {};
+      w.put<L::ID>(ID);
+      w.put<L::AccessType>(AccessType);
+      w.put<L::Attr>(Attr);
+      w.put<L::Estab_item>(Estab_item);
+      w.put<L::NodeID>(NodeID);
+      w.put<L::inLinkID_lo>(inLinkID);
+      w.put<L::inLinkID_hi>(inLinkID >> 24);
+      w.put<L::outLinkID>(outLinkID);
+
+      if ( out.tiled ) {
+         out.tile(MapID);
+      }
+      _write_words(out, w);
+      out.rows++;
+      batch.row(arena);
+   }
+   batch.report(arena);
+}
+
+/*!
+ *  \brief  encode the C-CR-Toll records of the C rows of the statement
+ *
+ *  The CR, Toll ETA and Toll pattern rows of a C row are selected on the
+ *  same connection.
+ */
+static void _scan_C_CR_Toll(CCmSqlite& db, CCmSqlite::statement* sel, CCmRangeOut& out, C_RecTables* tabs, bool overflow)
+{
+   C_CR_Toll_Record rec;
+   rec.overflow = overflow;
+   CCmArena arena;
+   row_batch batch(TABLE_C);
+   row_memo memo;
+   size_t bad_CR = 0, bad_ETA = 0, bad_Ptn = 0;   // the rows of the bad numbers left out of the records
+   typedef schema_C S;
+   schema_row<S> row(sel);
+   while(sel->step_row())
+   {
+      uint64_t InLinkId = 0, OutLinkId = 0, CondType = 0;
+      uint32_t MapID = 0;
+      bool hasInLinkId       = row.has<S::inLinkId>();
+      bool hasOutLinkId      = row.has<S::outLinkId>();
+      if ( ! row.opt_u64<S::inLinkId>(InLinkId) || ! row.opt_u64<S::outLinkId>(OutLinkId)
+         || ! row.u64<S::CondType>(CondType) || ( out.tiled && ! row.u32<S::MapID>(MapID) ) )
+      {
+         batch.skip(arena);
+         continue;
+      }
+
+      _C_record_begin(rec, hasInLinkId, InLinkId, hasOutLinkId, OutLinkId, CondType);
+
+      // CRID
+      if( row.has<S::CRID>() )
+      {
+         auto stmt_sel_CR = db.cached_statement("select * from " TABLE_CR " where CRID == ?;");
+         if ( stmt_sel_CR ) 
+         {
+            typedef schema_CR S_CR;
+            schema_row<S_CR> row_CR(stmt_sel_CR);
+            row.bind_to<S::CRID>(stmt_sel_CR, 1);
+            CR_RowData buf;
+            while(stmt_sel_CR->step_row())
+            {
+               uint64_t CRID = 0;
+               if ( row_CR.u64<S_CR::CRID>(CRID) && _CR_row2data(memo, CRID, row_CR.text<S_CR::VPeriod>(),
+                  row_CR.text<S_CR::VPDir>(), row_CR.text<S_CR::Vehcl_Type>(), row_CR.text<S_CR::VP_Approx>(), buf) )
+               {
+                  _C_record_add_CR(rec, buf);
+               }
+               else
+               {
+                  bad_CR++;
+               }
+            }
+
+            if ( _C_record_end_CR(rec) > 1 )
+            {
+               CM_LOG_INFO("%s CRID %s, cnt %d. ", LOG_HEADER, row.text<S::CRID>().str().c_str(), rec.header.cnt_CRID);
+            }
+         }
+      }
+
+      if ( row.has<S::CondID>() ) 
+      {
+         // Toll ETA
+         auto stmt_sel_TollETA = db.cached_statement("select * from " TABLE_Toll_ETA " where CondID == ?;");
+         if(stmt_sel_TollETA)
+         {
+            typedef schema_Toll_ETA S_ETA;
+            schema_row<S_ETA> row_ETA(stmt_sel_TollETA);
+            row.bind_to<S::CondID>(stmt_sel_TollETA, 1);
+
+            TollETA_RowData buf;
+            CCmStrView lane;
+            size_t eta_cnt = 0;
+            bool eta_ok = false;
+            while ( stmt_sel_TollETA->step_row() ) 
+            {
+               uint64_t CondID = 0;
+               eta_ok = row_ETA.u64<S_ETA::CondId>(CondID) && _TollETA_row2data(arena, memo, CondID, row_ETA.text<S_ETA::TollMode>(),
+                  row_ETA.text<S_ETA::CardMode>(), row_ETA.text<S_ETA::TollType>(), buf, lane);
+               eta_cnt++;
+            }
+
+            if ( eta_cnt == 1 && ! eta_ok ) {
+               bad_ETA++;
+            }
+            else if ( eta_cnt == 1 ) {
+               _C_record_set_ETA(rec, buf, lane);
+            }
+            else if ( eta_cnt > 1 ) {
+               CM_LOG_WARNING("%s[Toll] unexpected the Toll ETA number %d.", LOG_HEADER, eta_cnt);
+            }
+         }
+
+         // Toll pattern
+         auto stmt_sel_TollPattern = db.cached_statement("select * from " TABLE_Toll_Pattern " where CondID == ?;");
+         if ( stmt_sel_TollPattern ) {
+            typedef schema_Toll_Pattern S_Ptn;
+            schema_row<S_Ptn> row_Ptn(stmt_sel_TollPattern);
+            row.bind_to<S::CondID>(stmt_sel_TollPattern, 1);
+
+            TollPattern_RowData buf;
+            size_t ptn_cnt = 0;
+            bool ptn_ok = false;
+            while ( stmt_sel_TollPattern->step_row() )
+            {
+               uint64_t CondID = 0;
+               ptn_ok = row_Ptn.u64<S_Ptn::CondId>(CondID)
+                  && _TollPattern_row2data(CondID, row_Ptn.text<S_Ptn::Pattern>(), row_Ptn.text<S_Ptn::ArrowNo>(), buf);
+               ptn_cnt++;
+            }
+
+            if ( ptn_cnt == 1 && ! ptn_ok ) {
+               bad_Ptn++;
+            }
+            else if ( ptn_cnt == 1 ) {
+               _C_record_set_pattern(rec, buf);
+            }
+            else if ( ptn_cnt > 1 ) {
+               CM_LOG_WARNING("%s[Toll] unexpected the pattern number %d.", LOG_HEADER, ptn_cnt);
+            }
+         }
+      }
+
+      if ( out.tiled ) {
+         out.tile(MapID);
+      }
+      _C_record_write(out, rec, tabs);
+      batch.row(arena);
+
+      if ( ++out.rows % 100 == 0 )
+      {
+         CM_LOG_INFO("%s stepped %zu rows", LOG_HEADER, out.rows);
+      }
+   }
+
+
+   batch.report(arena);
+   memo.report();
+   if ( bad_CR + bad_ETA + bad_Ptn > 0 )
+   {
+      CM_LOG_WARNING("%s %zu CR, %zu Toll ETA and %zu Toll pattern rows of the bad numbers left out of the records.",
+         LOG_HEADER, bad_CR, bad_ETA, bad_Ptn);
+   }
+}
+
+/// \brief copy the table of the DB file into the DB by "create table as select"
+static bool _copy_table(CCmSqlite& db, const char* path, const char* table)
+{
+   const char* alias = "DB_SRC";
+   bool ok = db.attach(path, alias);
+   if ( ok ) 
+   {
+      std::ostringstream os;
+      os << "create table " << table << " as select * from " << alias << "." << table << ";";
+      ok = db.execute(os.str().c_str());
+      ok = db.detach(alias) && ok;
+   }
+   else
+   {
+      CM_LOG_WARNING("%s failed attach : \"%s\"!", LOG_HEADER, path);
+   }
+   return ok;
+}
+
+/*!
+ *  \brief  copy the tables of the DB files into the DB concurrently
+ *
+ *  Each table is copied on a worker thread by its own connection, into a
+ *  staging memory DB of the shared cache. The staging DBs are then attached
+ *  to the DB in turn and their records are copied as they are, which is far
+ *  cheaper than reading the DB files. So the time is about the one of the
+ *  largest table instead of the sum.
+ */
+static std::bitset<4> _copy_tables_parallel(CCmSqlite& db, const char* path[4], const char* table[4], size_t workers)
+{
+   std::unique_ptr<CCmSqlite> stage[4];
+   bool staged[4] = {false};
+   auto uri = [&](size_t i){
+      return std::string("file:cm_stage_") + table[i] + "?mode=memory&cache=shared";
+   };
+
+   std::atomic<size_t> next(0);
+   auto work = [&](){
+      for (size_t i = next++; i < 4; i = next++)
+      {
+         try
+         {
+            stage[i].reset(new CCmSqlite(uri(i).c_str()));
+            staged[i] = _copy_table(*stage[i], path[i], table[i]);
+         }
+         catch(std::exception& e)
+         {
+            CM_LOG_ERROR("%s staging %s : %s", LOG_HEADER, table[i], e.what());
+         }
+      }
+   };
+
+   std::vector<std::thread> pool;
+   for (size_t w = 1; w < workers; ++w)
+   {
+      pool.emplace_back(work);
+   }
+   work();
+   for (auto& t : pool)
+   {
+      t.join();
+   }
+   CM_LOG_INFO("%s %zu tables staged on %zu threads.", LOG_HEADER, std::count(staged, staged + 4, true), workers);
+
+   std::bitset<4> ret("0000");
+   const char* alias = "DB_STAGE";
+   for (size_t i = 0; i < 4; ++i)
+   {
+      if ( staged[i] && db.attach(uri(i).c_str(), alias) ) 
+      {
+         ret[i] = db.copy_table(alias, table[i]);
+         ret[i] = db.detach(alias) && ret[i];
+      }
+      stage[i].reset();
+   }
+   return ret;
+}
+
+bool CCmDatabase::isLeadSameIcStr(const std::string& src, const std::string& dst, std::string::size_type n)
+{
+   auto m = std::min(dst.length(), src.length());
+   if ( std::string::npos == n ) 
+   {
+      n = m;
+   }
+   else
+   {
+      n = std::min(n, m);
+   }
+   
+   bool is_same = true;
+   for ( decltype(n) i = 0; i < n; ++i ) 
+   {
+      auto& a = src[i];
+      auto& b = dst[i];
+      if ( a != b ) 
+      {
+         if(std::isalpha(a, m_loc) && std::isalpha(b, m_loc))
+         {
+            if(std::tolower(a, m_loc) != std::tolower(b, m_loc))
+            {
+               is_same = false;
+               break;
+            }
+         }
+         else
+         {
+            is_same = false;
+            break;
+         }
+      }
+   }
+
+   //CM_LOG_INFO("%s %s , %s is %s", LOG_HEADER, src.c_str(), dst.c_str(), is_same ? "same": "not same");
+   return is_same;
+}
+void CCmDatabase::fit_to_graph(std::string& s)
+{
+   auto pred = [this](const char& c){return std::isgraph(c, this->m_loc);};
+   auto it = std::find_if(s.begin(), s.end(), pred);
+   if(s.end() != it)
+   {
+      ///< remove leading white space
+      std::string::size_type num = std::distance(s.begin(), std::next(it));
+      s.erase(0, num);
+   }
+
+   auto rit = std::find_if(s.rbegin(), s.rend(), pred);
+   if ( s.rend() != rit ) 
+   {
+      ///< erase ending white space
+      std::string::size_type num = std::distance(s.rbegin(), std::next(rit));
+      auto pos = s.size() - num;
+      s.erase(pos);
+   }
+}
+
+std::tuple<std::string, std::string, std::string> CCmDatabase::parse_path(const std::string& path)
+{
+   std::string dir, basename, ext;
+   std::string filename = path;
+
+   auto pos  = path.find_last_of('/');
+   if ( std::string::npos != pos ) 
+   {
+      dir = path.substr(0, pos);
+      filename = path.substr(pos + 1);
+   }
+
+   basename = filename;
+   pos = filename.find_last_of('.');
+   if ( std::string::npos != pos ) 
+   {
+      ext = filename.substr(pos + 1);
+      basename = filename.substr(0, pos);
+   }
+
+   return std::make_tuple(std::ref(dir), std::ref(basename), std::ref(ext));
+}
+//-----------------------------------------------------------------------------
+//  Implement Section For class CCmDatabase
+//-----------------------------------------------------------------------------
+CCmDatabase::CCmDatabase(const CCmOption& opt)
+: m_db(nullptr)
+, m_opt(opt)
+, m_loc("")
+{
+}
+
+CCmDatabase::~CCmDatabase()
+{
+   if ( m_db ) 
+   {
+      delete m_db;
+   }
+   if ( ! m_work.empty() ) 
+   {
+      std::remove(m_work.c_str());
+   }
+}
+
+/*!
+ *  \brief  import "*.mid" files
+ * \param path the mid file path.\n
+ * The mid file base name should be leading by Toll_ETA, Toll_Patern
+ * \return import OK or not 
+ * \retval true import OK
+ * \retval false import failed
+ *
+ */
+bool CCmDatabase::import_mid(const char* path)
+{
+   bool ok = true;
+
+   if ( path ) 
+   {
+      std::string dir, basename, ext;
+      auto result = parse_path(std::string(path));
+      std::tie(dir, basename, ext) = result;
+
+      CM_LOG_INFO("%s dir \"%s\", basename \"%s\", ext \"%s\".", LOG_HEADER, dir.c_str(), basename.c_str(), ext.c_str());
+      if ( ! basename.empty() && ext == "mid") 
+      {
+         std::string db_path = basename + '.' + "db";
+         if( ! dir.empty())
+         {
+            db_path = dir + '/' + db_path;
+         }
+         bool is_opened = open_work_db(db_path.c_str());
+         if ( is_opened ) 
+         {
+            switch ( _bname_kind(basename) )
+            {
+               case BNAME_N:
+                  is_opened = open_mid<schema_N>(path);
+                  break;
+
+               case BNAME_C:
+                  is_opened = open_mid<schema_C>(path);
+                  break;
+
+               case BNAME_CR:
+                  is_opened = open_mid<schema_CR>(path);
+                  break;
+
+               case BNAME_Toll_ETA:
+                  is_opened = open_mid<schema_Toll_ETA>(path);
+                  break;
+
+               case BNAME_Toll_Pattern:
+                  is_opened = open_mid<schema_Toll_Pattern>(path);
+                  break;
+
+               case BNAME_HW_Junction:
+                  is_opened = open_mid<schema_HW_Junction>(path);
+                  break;
+
+               default:
+                  CM_LOG_WARNING("%s the \"%s\" don't match any targets!", LOG_HEADER, basename.c_str());
+                  is_opened = false;
+                  break;
+            }
+         }
+
+         if(is_opened)
+         {
+            ok = save_as(db_path.c_str());
+            if(!ok)
+            {
+               CM_LOG_WARNING("%s save as \"%s\" failed!", LOG_HEADER, db_path.c_str());
+            }
+         }
+      }
+      else
+      {
+         CM_LOG_WARNING("%s inpute path is not illegal : basename \"%s\", ext \"%s\".", LOG_HEADER, basename.c_str(), ext.c_str());
+      }
+   }
+   else 
+   {
+      CM_LOG_ERROR("%s the input path is NULL!", LOG_HEADER);
+      ok = false;
+   }
+
+   return ok;
+}
+
+/*!
+ *  \brief  create the table of the schema and insert the lines of its mid file
+ *
+ *  In the typed schema the ID fields are stored as INTEGER and bound by
+ *  integer; the empty or not numeric values of them are kept as text.
+ *
+ *  A line rejected by the table, i.e. the CondID of Toll_ETA or Toll_Pattern
+ *  duplicated, is not inserted; the first REJECT_LOG_NUM of them are logged
+ *  with the error, and the number of them at last.
+ */
+template<typename S>
+bool CCmDatabase::open_mid(const char* path)
+{
+   bool ok = false;
+
+   if ( nullptr != path && ! _schema_named<S>() )
+   {
+      CM_LOG_ERROR("%s schema of table %s lacks the name of a field!", LOG_HEADER, S::table);
+   }
+   else if ( nullptr != path ) 
+   {
+      std::string sql = _schema_create_sql<S>(m_opt.typed);
+      std::string sqlins = _schema_insert_sql<S>();
+
+      ok = m_db->execute( sql.c_str() );
+      if ( ! ok )
+      {
+         CM_LOG_ERROR("%s create table \"%s\" failed!", LOG_HEADER, sql.c_str());
+      }
+
+      auto stmt = ok ? m_db->create_statement(sqlins.c_str()) : nullptr;
+      if (stmt)
+      {
+         CM_LOG_INFO("%s open \"%s\", field number : %d, insert SQL is \"%s\", %s scanner.", LOG_HEADER, path, S::FIELD_NUM, sqlins.c_str(), cm_scan_isa());
+         CCmMidReader mid(path, S::FIELD_NUM, m_opt.threads);
+         if (mid.is_open())
+         {
+            size_t lineno = 0;
+            size_t rejected = 0;
+            // NOTE : the the fields to bind have to be the same life cycle with the statement step.
+            while (const CCmStrView* field = mid.next())
+            {
+               schema_bind<S>::bind(stmt, field, m_opt.typed);
+            
+               bool inserted = stmt->step();
+               stmt->reset();
+               if ( ! inserted && rejected++ < REJECT_LOG_NUM )
+               {
+                  CM_LOG_WARNING("%s line %zu of \"%s\" rejected, %s.", LOG_HEADER, lineno + 1, path, stmt->error());
+               }
+
+               decltype(lineno) print_step = 1000;
+               if ( 0 == lineno++ % print_step ) 
+               {
+                  CM_LOG_INFO("%s ====> line NO:%d", LOG_HEADER, lineno);
+               }
+            }
+            CM_LOG_INFO("%s ====>last line NO:%d", LOG_HEADER, ++lineno);
+            if ( rejected > 0 )
+            {
+               CM_LOG_WARNING("%s %zu lines of \"%s\" rejected by table %s.", LOG_HEADER, rejected, path, S::table);
+            }
+         }
+         else
+         {
+            CM_LOG_ERROR("%s open %s failed!", LOG_HEADER, path);
+            ok = false;
+         }
+      }
+
+   }
+   else 
+   {
+      CM_LOG_ERROR("%s Illegal parameters : open path is NULL, table is %s.", LOG_HEADER, S::table);
+   }
+   return ok;
+}
+
+bool CCmDatabase::save_as(const char* path)
+{
+   if ( m_work.empty() ) 
+   {
+      return m_db->backup(path);
+   }
+
+   // the work DB is the one to save already
+   delete m_db;
+   m_db = nullptr;
+#if defined(_WIN32)
+   // rename doesn't replace the existing file on Windows
+   if ( 0 != std::remove(path) && ENOENT != errno )
+   {
+      CM_LOG_WARNING("%s remove \"%s\" failed, %s!", LOG_HEADER, path, std::strerror(errno));
+   }
+#endif
+   bool ok = 0 == std::rename(m_work.c_str(), path);
+   if ( ok ) 
+   {
+      m_work.clear();
+   }
+   else
+   {
+      CM_LOG_ERROR("%s rename \"%s\" to \"%s\" failed, %s!", LOG_HEADER, m_work.c_str(), path, std::strerror(errno));
+   }
+   return ok;
+}
+
+/*!
+ *  \brief  open the DB to build and save as the path
+ *
+ *  It is the memory DB, but under the memory limit (--mem-limit) a work file
+ *  beside the path, whose page cache is half the limit and whose temporary
+ *  tables and sorts are on the disk too, so the joins of the combine spill
+ *  to the disk. save_as() renames the work file to the path then.
+ */
+bool CCmDatabase::open_work_db(const char* path)
+{
+   if ( 0 == m_opt.mem_limit ) 
+   {
+      return open_db(MEM_DB);
+   }
+
+   m_work = std::string(path) + WORK_DB_EXT;
+   std::remove(m_work.c_str());
+   bool ok = open_db(m_work.c_str());
+   if ( ok ) 
+   {
+      std::string sql = "PRAGMA cache_size = -" + std::to_string(std::max<size_t>(m_opt.mem_limit / 2 / 1024, 1))
+         + "; PRAGMA temp_store = FILE; PRAGMA journal_mode = OFF; PRAGMA synchronous = OFF;";
+      ok = m_db->execute(sql.c_str());
+   }
+   return ok;
+}
+
+/// \brief open the DB, the read only one is memory mapped for the parse_db_xxx readers
+bool CCmDatabase::open_db(const char* path, bool readonly)
+{
+   bool ok = false;
+   if (path && nullptr == m_db)
+   {
+      try
+      {
+         m_db = new CCmSqlite(path, readonly);
+         m_db->set_profile(m_opt.profile);
+         m_db_path = path;
+         ok = true;
+      }
+      catch(std::exception& e)
+      {
+         CM_LOG_ERROR("%s %s", LOG_HEADER, e.what());
+      }
+   }
+   else
+   {
+      CM_LOG_ERROR("%s DB path : \"%s\", DB pointer %p!", LOG_HEADER, path, m_db);
+   }
+
+   return ok;
+}
+
+/*!
+ *  \brief  scan the table of the opened DB by rowid ranges on the threads
+ *
+ *  With more than one thread (-j), the rowids of the table are split into
+ *  one range per thread. Every range is selected on a read only connection
+ *  of its own and encoded by scan() into its own buffer. The buffers are
+ *  given to put() in the rowid order, so the bin is the same as the one of a
+ *  single scan, whose rows are in the rowid order too. With one thread, the
+ *  table is scanned on the opened DB and encoded into the bin directly.
+ *
+ *  Under the memory limit (--mem-limit), the ranges are scanned in rounds of
+ *  one range per thread, and put() after each round. The first round scans
+ *  PROBE_ROWIDS rowids a range, the next ones as many as the bytes of the
+ *  last round tell to fit in half the limit. The tiled single scan is split
+ *  so too, as all its rows would be buffered.
+ *
+ *  \param  table    the table
+ *  \param  cond     the condition of the rows, or nullptr for all
+ *  \param  bin      the bin
+ *  \param  scan     scan(db, statement, out) encodes the rows of the statement
+ *  \param  put      put(out) writes the range in order, the buffer is written
+ *                   as it is by default
+ *  \param  tiled    the ranges, even the only one, are buffered with the
+ *                   MapIDs of the records, for the put to group them
+ */
+bool CCmDatabase::scan_table(const char* table, const char* cond, CCmBinWriter& bin, const range_scan& scan, const range_put& put, bool tiled)
+{
+   bool ok = false;
+   auto write = [&](CCmRangeOut& out){
+      if ( put ) {
+         put(out);
+      }
+      else if ( nullptr == out.bin ) {
+         bin.write(out.buf.data(), out.buf.size());
+      }
+   };
+
+   const std::string where = cond ? std::string(" where ") + cond : std::string();
+   const size_t threads = std::max<size_t>(m_opt.threads, 1);
+   if ( 1 == threads && ! (tiled && m_opt.mem_limit > 0) ) 
+   {
+      std::string sql = std::string("select * from ") + table + where + ";";
+      auto sel = m_db->cached_statement(sql.c_str());
+      if ( sel ) 
+      {
+         CCmRangeOut out(tiled ? nullptr : &bin, bin.big_endian(), tiled);
+         scan(*m_db, sel, out);
+         sel->reset();
+         write(out);
+         ok = true;
+      }
+      return ok;
+   }
+
+   // the rowid ranges, empty if hi < lo
+   int64_t lo = 1, hi = 0;
+   std::string sql = std::string("select min(rowid), max(rowid) from ") + table + ";";
+   auto bound = m_db->cached_statement(sql.c_str());
+   if ( bound && bound->step_row() && SQLITE_NULL != bound->get_type(0) ) 
+   {
+      lo = bound->get_int64(0);
+      hi = bound->get_int64(1);
+   }
+   if ( bound ) 
+   {
+      bound->reset();
+   }
+   uint64_t step = (hi < lo) ? 0 : (static_cast<uint64_t>(hi - lo) + threads) / threads;
+   const size_t budget = m_opt.mem_limit / 2;
+   if ( budget > 0 ) 
+   {
+      step = std::min(step, PROBE_ROWIDS);
+   }
+
+   sql = std::string("select * from ") + table + " where rowid between ? and ?" + (cond ? std::string(" and (") + cond + ")" : std::string()) + ";";
+   size_t rounds = 0;
+   try
+   {
+      CCmSqlitePool pool(m_db_path.c_str(), threads);
+      std::atomic<size_t> failed(0);
+      std::vector<CCmRangeOut> out;
+      uint64_t base = static_cast<uint64_t>(lo);
+      auto work = [&](size_t i){
+         auto first = base + step * i;
+         if ( step > 0 && first <= static_cast<uint64_t>(hi) ) 
+         {
+            auto db = pool.acquire();
+            auto sel = db->cached_statement(sql.c_str());
+            if ( sel ) 
+            {
+               sel->bind_int64(1, static_cast<int64_t>(first));
+               sel->bind_int64(2, static_cast<int64_t>(std::min(first + step - 1, static_cast<uint64_t>(hi))));
+               scan(*db, sel, out[i]);
+               sel->reset();
+            }
+            else
+            {
+               failed++;
+            }
+         }
+      };
+
+      ok = true;
+      do
+      {
+         out.assign(threads, CCmRangeOut(nullptr, bin.big_endian(), tiled));
+         std::vector<std::thread> pool_thread;
+         for (size_t i = 1; i < threads; ++i)
+         {
+            pool_thread.emplace_back(work, i);
+         }
+         work(0);
+         for (auto& t : pool_thread)
+         {
+            t.join();
+         }
+         ok = 0 == failed;
+
+         size_t bytes = 0;
+         for (size_t i = 0; ok && i < threads; ++i)
+         {
+            bytes += out[i].buf.size();
+            write(out[i]);
+            std::string().swap(out[i].buf);
+         }
+         base += step * threads;
+         rounds++;
+         if ( budget > 0 && bytes > 0 ) 
+         {
+            // the rowids to fit the budget by the bytes a rowid of this round
+            step = std::max<uint64_t>(1, static_cast<uint64_t>(static_cast<double>(budget) / bytes * step));
+         }
+      } while ( ok && budget > 0 && step > 0 && base <= static_cast<uint64_t>(hi) );
+   }
+   catch(std::exception& e)
+   {
+      CM_LOG_ERROR("%s %s", LOG_HEADER, e.what());
+      ok = false;
+   }
+
+   CM_LOG_INFO("%s %s scanned by %zu rowid ranges in %zu rounds.", LOG_HEADER, table, threads, rounds);
+   return ok;
+}
+
+bool CCmDatabase::parse_db(const char* path)
+{
+   bool ok = true;
+
+   if ( path ) 
+   {
+      std::string dir, basename, ext;
+      std::tie(dir, basename, ext) = parse_path(std::string(path));
+
+      CM_LOG_INFO("%s dir \"%s\", basename \"%s\", ext \"%s\".", LOG_HEADER, dir.c_str(), basename.c_str(), ext.c_str());
+      if ( ! basename.empty() && ext == "db") 
+      {
+         auto bin_path = [&](){
+            std::string bp = basename + '.' + "bin";
+            if( ! dir.empty())
+            {
+               bp = dir + '/' + bp;
+            }
+            return bp;
+         };
+
+         typedef bool (CCmDatabase::*db_parse)(const char*);
+         db_parse parse = nullptr;
+         switch ( _bname_kind(basename) )
+         {
+            case BNAME_N:
+               parse = &CCmDatabase::parse_db_N;
+               break;
+
+            case BNAME_CR:
+               parse = &CCmDatabase::parse_db_CR;
+               break;
+
+            case BNAME_Toll_ETA:
+               parse = &CCmDatabase::parse_db_Toll_ETA;
+               break;
+
+            case BNAME_Toll_Pattern:
+               parse = &CCmDatabase::parse_db_Toll_Pattern;
+               break;
+
+            case BNAME_C_CR_Toll:
+               parse = &CCmDatabase::parse_db_C_CR_Toll;
+               break;
+
+            case BNAME_HW_Junction:
+               parse = &CCmDatabase::parse_db_HW_Junction;
+               break;
+
+            default:
+               CM_LOG_WARNING("%s the \"%s\" don't match any targets!", LOG_HEADER, basename.c_str());
+               break;
+         }
+
+         if ( parse && open_db(path, true) ) 
+         {
+            ok = (this->*parse)(bin_path().c_str());
+         }
+
+      }
+      else
+      {
+         CM_LOG_WARNING("%s inpute path is not illegal : basename \"%s\", ext \"%s\".", LOG_HEADER, basename.c_str(), ext.c_str());
+      }
+   }
+   else 
+   {
+      CM_LOG_ERROR("%s the input path is NULL!", LOG_HEADER);
+      ok = false;
+   }
+
+   return ok;
+}
+
+bool CCmDatabase::parse_db_CR(const char* bin_path)
+{
+   bool ok = false;
+
+   if ( nullptr != bin_path ) 
+   {
+      CCmBinWriter bin(bin_path, m_opt.big_endian);
+      if ( bin.is_open() ) 
+      {
+         CM_LOG_INFO("%s %s open OK.", LOG_HEADER, bin_path);
+         ok = scan_table(TABLE_CR, nullptr, bin, _scan_CR) && bin.close();
+      }
+   }
+
+   return ok;
+}
+
+bool CCmDatabase::parse_db_Toll_ETA(const char* bin_path)
+{
+   bool ok = false;
+
+   if ( nullptr != bin_path ) 
+   {
+      CCmBinWriter bin(bin_path, m_opt.big_endian);
+      if ( bin.is_open() ) 
+      {
+         CM_LOG_INFO("%s %s open OK.", LOG_HEADER, bin_path);
+         const bool overflow = m_opt.overflow;
+         auto scan = [overflow](CCmSqlite& db, CCmSqlite::statement* sel, CCmRangeOut& out)
+         {
+            _scan_Toll_ETA(db, sel, out, overflow);
+         };
+         ok = scan_table(TABLE_Toll_ETA, nullptr, bin, scan) && bin.close();
+      }
+   }
+
+   return ok;
+}
+
+bool CCmDatabase::parse_db_Toll_Pattern(const char* bin_path)
+{
+   bool ok = false;
+
+   if ( nullptr != bin_path ) 
+   {
+      CCmBinWriter bin(bin_path, m_opt.big_endian);
+      if ( bin.is_open() ) 
+      {
+         CM_LOG_INFO("%s %s open OK.", LOG_HEADER, bin_path);
+         ok = scan_table(TABLE_Toll_Pattern, nullptr, bin, _scan_Toll_Pattern) && bin.close();
+      }
+   }
+
+   return ok;
+}
+
+/*!
+ *  \brief  parse DB file for HighWay Junction
+ */
+bool CCmDatabase::parse_db_HW_Junction(const char* bin_path)
+{
+   bool ok = false;
+
+   if ( nullptr != bin_path ) 
+   {
+      CCmBinWriter bin(bin_path, m_opt.big_endian);
+      if ( bin.is_open() ) 
+      {
+         CM_LOG_INFO("%s %s open OK.", LOG_HEADER, bin_path);
+         if ( m_opt.tiled ) 
+         {
+            CCmSpill tiles(m_opt.mem_limit / 2, std::get<0>(parse_path(bin_path)));
+            auto collect = [&tiles](CCmRangeOut& out){ _tiles_add(tiles, out); };
+            ok = scan_table(TABLE_HW_Junction, nullptr, bin, _scan_HW_Junction, collect, true)
+               && _tiles_write(bin, tiles, [&bin](const char* p, size_t n){ bin.write(p, n); }) && bin.close();
+         }
+         else
+         {
+            ok = scan_table(TABLE_HW_Junction, nullptr, bin, _scan_HW_Junction) && bin.close();
+         }
+      }
+   }
+
+   return ok;
+}
+
+/*!
+ *  \brief  parse DB file for the nodes, into the CSR adjacency bin
+ *
+ *  The nodes are sorted by ID, the neighbors and the links of the node i are
+ *  nbr[nbr_off[i], nbr_off[i + 1]) and link[link_off[i], link_off[i + 1]).
+ *  A main node and its sub nodes are the neighbors of each other, and the
+ *  node adjoined in the other mesh is the neighbor with its mesh.
+ *
+ *  The nodes, the edges and the offsets are sorted and built in memory, as
+ *  the offsets of a node need its edges all together, so --mem-limit is
+ *  not kept here; the bytes over the limit are warned.
+ */
+bool CCmDatabase::parse_db_N(const char* bin_path)
+{
+   bool ok = false;
+   auto sel = m_db->cached_statement("select * from " TABLE_N ";");
+   if ( nullptr != sel && nullptr != bin_path ) 
+   {
+      const uint64_t id_mask = (1ULL << 40) - 1;
+      const uint64_t mesh_mask = (1ULL << 20) - 1;
+      auto nbr_of = [&](uint64_t id, uint64_t kind, uint64_t mesh){
+         return (id & id_mask) | (kind << 40) | ((mesh & mesh_mask) << 44);
+      };
+
+      std::vector<std::pair<uint64_t, uint32_t>> node;   // ID, attributes
+      std::vector<std::pair<uint64_t, uint64_t>> nbr;    // ID, neighbor
+      std::vector<std::pair<uint64_t, uint64_t>> link;   // ID, link ID
+      CCmArena arena;
+      row_batch batch(TABLE_N);
+      typedef schema_N S;
+      schema_row<S> row(sel);
+      while ( sel->step_row() )
+      {
+         uint64_t ID = 0, mainID = 0, adjoinID = 0;
+         uint32_t mesh = 0, cross = 0, light = 0, adjoinMesh = 0;
+         bool hasMain      = row.has<S::mainNodeID>();
+         auto txtSub       = row.text<S::subNodeID>();
+         auto txtSub2      = row.text<S::subNodeID2>();
+         bool hasAdjoin    = row.has<S::Adjoin_NID>();
+         auto txtLinks     = row.text<S::Node_LID>();
+         bool row_ok = row.u64<S::ID>(ID) && row.u32<S::MapID>(mesh) && row.u32<S::Cross_flag>(cross)
+            && row.u32<S::Light_flag>(light) && row.opt_u64<S::mainNodeID>(mainID) && row.opt_u64<S::Adjoin_NID>(adjoinID)
+            && ( ! hasAdjoin || _parse_u32(row.text<S::Adjoin_MID>(), adjoinMesh) );
+         ID &= id_mask;
+
+         // the edges of the row are taken back if a sub node or link ID of it is bad
+         const size_t nbr_mark = nbr.size(), link_mark = link.size();
+         if ( row_ok && hasMain && mainID != ID ) 
+         {
+            nbr.push_back(std::make_pair(ID, nbr_of(mainID, N_NBR_MAIN, 0)));
+            nbr.push_back(std::make_pair(mainID & id_mask, nbr_of(ID, N_NBR_SUB, 0)));
+         }
+         auto sub = [&](const CCmStrView& e){
+            uint64_t subID = 0;
+            row_ok = row_ok && _parse_u64(e, subID);
+            subID &= id_mask;
+            if ( row_ok && subID != ID ) 
+            {
+               nbr.push_back(std::make_pair(ID, nbr_of(subID, N_NBR_SUB, 0)));
+               nbr.push_back(std::make_pair(subID, nbr_of(ID, N_NBR_MAIN, 0)));
+            }
+         };
+         _strdiv(txtSub, '|', sub);
+         _strdiv(txtSub2, '|', sub);
+         if ( row_ok && hasAdjoin ) 
+         {
+            nbr.push_back(std::make_pair(ID, nbr_of(adjoinID, N_NBR_ADJOIN, adjoinMesh)));
+         }
+         _strdiv(txtLinks, '|', [&](const CCmStrView& e){
+            uint64_t linkID = 0;
+            row_ok = row_ok && _parse_u64(e, linkID);
+            if ( row_ok )
+            {
+               link.push_back(std::make_pair(ID, linkID));
+            }
+         });
+         if ( ! row_ok )
+         {
+            nbr.resize(nbr_mark);
+            link.resize(link_mark);
+            batch.skip(arena);
+            continue;
+         }
+
+         if ( mesh > mesh_mask ) 
+         {
+            CM_LOG_WARNING("%s node %llu, mesh %u out of 20 bits.", LOG_HEADER, static_cast<unsigned long long>(ID), mesh);
+         }
+         node.push_back(std::make_pair(ID, (cross & 0x0F) | (light & 0x0F) << 4 | (mesh & 0xFFFFFF) << 8));
+         batch.row(arena);
+      }
+      batch.report(arena);
+      sel->reset();
+
+      const size_t mem = node.capacity() * sizeof(node[0]) + nbr.capacity() * sizeof(nbr[0]) + link.capacity() * sizeof(link[0]);
+      if ( m_opt.mem_limit > 0 && mem > m_opt.mem_limit )
+      {
+         CM_LOG_WARNING("%s the nodes and edges of %zu bytes are sorted in memory, over the memory limit %zu.",
+            LOG_HEADER, mem, m_opt.mem_limit);
+      }
+
+      // the first row of a duplicated ID is kept
+      std::stable_sort(node.begin(), node.end(), [](const std::pair<uint64_t, uint32_t>& a, const std::pair<uint64_t, uint32_t>& b){
+         return a.first < b.first;
+      });
+      auto node_end = std::unique(node.begin(), node.end(), [](const std::pair<uint64_t, uint32_t>& a, const std::pair<uint64_t, uint32_t>& b){
+         return a.first == b.first;
+      });
+      if ( node.end() != node_end ) 
+      {
+         CM_LOG_WARNING("%s %zu duplicated node IDs dropped.", LOG_HEADER, static_cast<size_t>(node.end() - node_end));
+         node.erase(node_end, node.end());
+      }
+      std::sort(nbr.begin(), nbr.end());
+      nbr.erase(std::unique(nbr.begin(), nbr.end()), nbr.end());
+      std::sort(link.begin(), link.end());
+      link.erase(std::unique(link.begin(), link.end()), link.end());
+
+      // the offsets, the edges of the IDs without node row are dropped
+      const bool big = m_opt.big_endian;
+      std::vector<uint32_t> nbr_off, link_off;
+      std::vector<uint64_t> nbr_csr, link_csr;
+      size_t k = 0, m = 0, dropped = 0, link_dropped = 0;
+      for (const auto& e : node)
+      {
+         nbr_off.push_back(_ord(static_cast<uint32_t>(nbr_csr.size()), big));
+         for (; k < nbr.size() && nbr[k].first <= e.first; ++k)
+         {
+            if ( nbr[k].first == e.first ) {
+               nbr_csr.push_back(_ord(nbr[k].second, big));
+            }
+            else {
+               dropped++;
+            }
+         }
+
+         link_off.push_back(_ord(static_cast<uint32_t>(link_csr.size()), big));
+         for (; m < link.size() && link[m].first <= e.first; ++m)
+         {
+            if ( link[m].first == e.first ) {
+               link_csr.push_back(_ord(link[m].second, big));
+            }
+            else {
+               link_dropped++;
+            }
+         }
+      }
+      nbr_off.push_back(_ord(static_cast<uint32_t>(nbr_csr.size()), big));
+      link_off.push_back(_ord(static_cast<uint32_t>(link_csr.size()), big));
+      dropped += nbr.size() - k;
+      link_dropped += link.size() - m;
+      if ( dropped > 0 || link_dropped > 0 ) 
+      {
+         CM_LOG_WARNING("%s %zu neighbors and %zu links of the IDs without node dropped.", LOG_HEADER, dropped, link_dropped);
+      }
+
+      CCmBinWriter bin(bin_path, m_opt.big_endian);
+      if ( bin.is_open() ) 
+      {
+         const uint32_t header[4] = {_ord(static_cast<uint32_t>(node.size()), big), _ord(static_cast<uint32_t>(nbr_csr.size()), big),
+            _ord(static_cast<uint32_t>(link_csr.size()), big), 0};
+         const char zero[16] = {0};
+         auto section = [&](const void* p, size_t n){
+            bin.write(p, n);
+            bin.write(zero, (16 - n % 16) % 16);
+         };
+
+         std::vector<uint64_t> ids;
+         std::vector<uint32_t> attr;
+         for (const auto& e : node)
+         {
+            ids.push_back(_ord(e.first, big));
+            attr.push_back(_ord(e.second, big));
+         }
+
+         bin.write(header, sizeof(header));
+         section(ids.data(), ids.size() * sizeof(ids[0]));
+         section(attr.data(), attr.size() * sizeof(attr[0]));
+         section(nbr_off.data(), nbr_off.size() * sizeof(nbr_off[0]));
+         section(nbr_csr.data(), nbr_csr.size() * sizeof(nbr_csr[0]));
+         section(link_off.data(), link_off.size() * sizeof(link_off[0]));
+         section(link_csr.data(), link_csr.size() * sizeof(link_csr[0]));
+         CM_LOG_INFO("%s %zu nodes, %zu neighbors, %zu links.", LOG_HEADER, node.size(), nbr_csr.size(), link_csr.size());
+         ok = bin.close();
+      }
+   }
+
+   return ok;
+}
+
+/*!
+ *  \brief  write the C-CR-Toll bin by the writer
+ *
+ *  The header is patched after all the records, at the head of the bin.
+ */
+bool CCmDatabase::parse_db_C_CR_Toll(CCmBinWriter& os)
+{
+   uint32_t row_num = 0;
+   size_t bin_size = 0;
+   const char header_zero[sizeof(C_RecHeader)] = {0};
+   auto bin_start = os.tell();
+   os.write(header_zero, sizeof(header_zero));
+
+   // the ranges scanned on the threads are written without the shared
+   // tables, which are put on as they are written in order
+   C_CRDict dict;
+   C_VPSlots slots;
+   C_VehIndex veh;
+   C_RecTables tabs = {m_opt.cr_dict ? &dict : nullptr, m_opt.vp_slots ? &slots : nullptr, m_opt.veh_index ? &veh : nullptr};
+   C_RecTables* ptabs = tabs.empty() ? nullptr : &tabs;
+   const bool overflow = m_opt.overflow;
+   auto scan = [ptabs, overflow](CCmSqlite& db, CCmSqlite::statement* sel, CCmRangeOut& out)
+   {
+      _scan_C_CR_Toll(db, sel, out, out.bin ? ptabs : nullptr, overflow);
+   };
+   CCmSpill tiles(m_opt.mem_limit / 2, std::get<0>(parse_path(m_db_path)));
+   auto put = [&](CCmRangeOut& out)
+   {
+      row_num += out.rows;
+      if ( m_opt.tiled ) {
+         _tiles_add(tiles, out);
+      }
+      else if ( out.bin || nullptr == ptabs ) {
+         os.write(out.buf.data(), out.buf.size());
+         bin_size += out.size;
+      }
+      else {
+         C_CR_Toll_Record rec;
+         for (size_t pos = 0; pos < out.buf.size(); )
+         {
+            pos += _C_record_read(out.buf.data() + pos, rec, out.big_endian());
+            bin_size += _C_record_write(os, rec, ptabs);
+         }
+      }
+   };
+
+   bool ok = scan_table(TABLE_C, R"(CondID != "" or CRID != "")", os, scan, put, m_opt.tiled);
+   if ( ok && m_opt.tiled ) 
+   {
+      C_CR_Toll_Record rec;
+      ok = _tiles_write(os, tiles, [&](const char* p, size_t n){
+         bin_size += _C_record_copy(os, p, n, rec, ptabs);
+      });
+   }
+   if ( ok ) 
+   {
+      _C_tables_write(os, tabs);
+      ok = _C_CR_Toll_header(os, bin_start, row_num, bin_size, tabs, m_opt.tiled, m_opt.overflow);
+   }
+
+   return ok;
+}
+
+
+bool CCmDatabase::parse_db_C_CR_Toll(const char* bin_path)
+{
+   bool ok = false;
+   CM_LOG_INFO("%s parse C-CR-Toll to \"%s\" .", LOG_HEADER, bin_path);
+
+   CCmBinWriter bin(bin_path, m_opt.big_endian);
+   if ( bin.is_open() && ( ! m_opt.validate || validate_db_C_CR_Toll() ) ) 
+   {
+      ok = parse_db_C_CR_Toll(bin) && bin.close();
+   }
+
+   return ok;
+}
+
+bool CCmDatabase::combine_db_C_CR(const char* path_C, const char* path_CR, const char* db_path)
+{
+   bool ok = false;
+
+   if ( path_C && path_CR && db_path) 
+   {
+      if ( open_work_db(db_path) ) 
+      {
+         const char* alias_C = "DB_C";
+         const char* alias_CR = "DB_CR";
+         ok = m_db->attach(path_C, alias_C);
+         if ( ok ) {
+            ok = m_db->attach(path_CR, alias_CR);
+            if ( ok ) 
+            {
+               std::string sql = "create table C_CR as select * from DB_C." TABLE_C " as C, DB_CR.CR as CR where C.CRID == CR.CRID;";
+               ok = m_db->execute(sql.c_str());
+               if ( ok ) 
+               {
+                  ok = m_db->detach(alias_C);
+                  if ( ok ) 
+                  {
+                     ok = m_db->detach(alias_CR);
+                     if ( ok ) 
+                     {
+                        CM_LOG_INFO("%s =======> OK" , LOG_HEADER);
+                        ok = save_as(db_path); 
+                        if ( !ok ) 
+                        {
+                           CM_LOG_WARNING("%s save as %s failed!", LOG_HEADER, db_path);
+                        }
+                     }
+                     else
+                     {
+                        CM_LOG_WARNING("%s failed detach : \"%s\"!", LOG_HEADER, alias_CR);
+                     }
+                  }
+                  else
+                  {
+                     CM_LOG_WARNING("%s failed detach : \"%s\"!", LOG_HEADER, alias_C);
+                  }
+               }
+               else
+               {
+                  CM_LOG_WARNING("%s failed create table : \"%s\"!", LOG_HEADER, sql.c_str());
+               }
+            }
+            else
+            {
+               CM_LOG_WARNING("%s failed attach : \"%s\"!", LOG_HEADER, path_CR);
+            }
+         }
+         else
+         {
+            CM_LOG_WARNING("%s failed attach : \"%s\"!", LOG_HEADER, path_C);
+         }
+      }
+   }
+   else 
+   {
+      CM_LOG_ERROR("%s illegal parameter C : %s, CR : %s, output DB path : %s", LOG_HEADER, path_C, path_CR, db_path);
+   }
+
+   return ok;
+}
+
+/*!
+ *  \brief  combine the C, CR, Toll ETA and Toll pattern DB files into one
+ *
+ *  With more than one thread (-j), the tables are copied concurrently, see
+ *  _copy_tables_parallel(), otherwise one after another on the memory DB.
+ */
+bool CCmDatabase::combine_db_C_CR_Toll(
+   const char* path_C, 
+   const char* path_CR, 
+   const char* path_Toll_ETA, 
+   const char* path_Toll_Pattern, 
+   const char* db_path)
+{
+   bool ok = false;
+
+   if ( path_C && path_CR && db_path && path_Toll_ETA && path_Toll_Pattern) 
+   {
+      if ( open_work_db(db_path) ) 
+      {
+         const char* path[4] = {path_C, path_CR, path_Toll_ETA, path_Toll_Pattern};
+         const char* table[4] = {TABLE_C, TABLE_CR, TABLE_Toll_ETA, TABLE_Toll_Pattern};
+
+         std::bitset<4> grp_ret("0000");
+         // the staging DBs of the parallel copy are in memory
+         const size_t workers = m_opt.mem_limit > 0 ? 1 : std::min<size_t>(m_opt.threads, grp_ret.size());
+         if ( workers > 1 && sqlite3_threadsafe() ) 
+         {
+            grp_ret = _copy_tables_parallel(*m_db, path, table, workers);
+         }
+         else
+         {
+            for (size_t i = 0; i < grp_ret.size(); ++i)
+            {
+               grp_ret[i] = _copy_table(*m_db, path[i], table[i]);
+            }
+         }
+
+         ok = grp_ret.all();
+         if ( ok ) 
+         {
+            ok = save_as(db_path); 
+            if ( ok ) 
+            {
+               CM_LOG_INFO("%s combine C-CR-Toll table OK!" , LOG_HEADER);
+            }
+            else
+            {
+               CM_LOG_WARNING("%s save as %s failed!", LOG_HEADER, db_path);
+            }
+         }
+         else
+         {
+            CM_LOG_WARNING("%s copy tables failed %s!", LOG_HEADER, grp_ret.to_string().c_str());
+         }
+      }
+   }
+   else 
+   {
+      CM_LOG_ERROR("%s illegal parameter C : %s, CR : %s, Toll ETA : %s, Toll Pattern : %s, output DB path : %s", 
+         LOG_HEADER, path_C, path_CR, path_Toll_ETA, path_Toll_Pattern, db_path);
+   }
+
+
+   return ok;
+}
+
+/*!
+ *  \brief  find the C, CR, Toll_ETA and Toll_Pattern files of one province
+ *  \param  v        (dir, basename, path) of the files
+ *  \param  path     the paths of C, CR, Toll_ETA and Toll_Pattern in order
+ *  \param  province the province of them
+ */
+static bool _match_C_CR_Toll(
+   const std::vector<std::tuple<std::string, std::string, std::string>>& v,
+   std::string (&path)[4],
+   std::string& province)
+{
+   static const bname_kind kind[4] = {BNAME_C, BNAME_CR, BNAME_Toll_ETA, BNAME_Toll_Pattern};
+
+   std::string prvnc[4];
+   for(auto& e : v)
+   {
+      std::string basname, file_path, m;
+      std::tie(std::ignore, basname, file_path) = e;
+      auto k = _bname_kind(basname, &m);
+
+      for(size_t i = 0; i < 4; ++i)
+      {
+         if ( path[i].empty() && k == kind[i] ) {
+            path[i] = file_path;
+            prvnc[i] = m;
+            break;
+         }
+      }
+   }
+
+   province = prvnc[0];
+   return std::all_of(std::begin(prvnc), std::end(prvnc), [&province](const std::string& s){return s == province;}) 
+       && std::all_of(std::begin(path),  std::end(path),  [](const std::string& s){return !s.empty();});
+}
+
+/// \brief whether a row of the key table doesn't fit in the bin, by its fields
+typedef bool (*key_over)(const CCmStrView*);
+
+static bool _key_fit(const CCmStrView*)
+{
+   return false;
+}
+
+/// \brief the lanes of the Toll ETA row
+static size_t _ETA_lanes(const CCmStrView* field)
+{
+   typedef schema_Toll_ETA S;
+   size_t lane = 0;
+   auto count = [&lane](const CCmStrView&){ lane++; };
+   _strdiv(field[S::TollMode], '|', count);
+   _strdiv(field[S::CardMode], '|', count);
+   return lane;
+}
+
+/// \brief the lanes of the Toll ETA row don't fit in the ETA block, which is dropped
+static bool _ETA_lane_over(const CCmStrView* field)
+{
+   return _lane_bytes(_ETA_lanes(field)) > sizeof(C_TollETABlock::laneinfo);
+}
+
+/// \brief the lanes of the Toll ETA row don't fit in the ETA block and the extension block, which are truncated, with the overflow
+static bool _ETA_lane_over_ext(const CCmStrView* field)
+{
+   return _ETA_lanes(field) > ETA_LANE_MAX + C_EXT_MAX;
+}
+
+/// \brief the loader of the keys, the field K of the schema S, from the mid file
+template<typename S, size_t K>
+static CCmValidator::key_load _mid_keys(const char* path, key_over over = _key_fit)
+{
+   return [path, over](CCmKeySet& keys){
+      CCmMidReader mid(path, S::FIELD_NUM);
+      while (const CCmStrView* field = mid.next())
+      {
+         keys.add(field[K], over(field));
+      }
+      return mid.is_open();
+   };
+}
+
+/// \brief the loader of the keys, the field K of the schema S, from the table on a connection of the pool
+template<typename S, size_t K>
+static CCmValidator::key_load _db_keys(CCmSqlitePool& pool, key_over over = _key_fit)
+{
+   return [&pool, over](CCmKeySet& keys){
+      auto db = pool.acquire();
+      const std::string sql = std::string("select * from ") + S::table + ";";
+      auto sel = db->cached_statement(sql.c_str());
+      CCmStrView field[S::FIELD_NUM];
+      while ( sel && sel->step_row() )
+      {
+         for (size_t i = 0; i < S::FIELD_NUM; ++i)
+         {
+            field[i] = sel->get_text_view(i);
+         }
+         keys.add(field[K], over(field));
+      }
+      if ( sel ) {
+         sel->reset();
+      }
+      return nullptr != sel;
+   };
+}
+
+/*!
+ *  \brief  validate the references of C against CR, Toll_ETA and
+ *          Toll_Pattern in the C-CR-Toll DB
+ *
+ *  The keys are loaded by the connections of their own, one table a thread.
+ *  The row of a sample is the rowid of C.
+ */
+bool CCmDatabase::validate_db_C_CR_Toll()
+{
+   bool ok = false;
+   CCmValidator check(_C_CR_limit(m_opt.overflow), m_opt.overflow, m_opt.threads);
+   try
+   {
+      CCmSqlitePool pool(m_db_path.c_str(), std::min<size_t>(m_opt.threads, CCmValidator::TABLE_NUM));
+      const CCmValidator::key_load loader[CCmValidator::TABLE_NUM] = {
+         _db_keys<schema_CR, schema_CR::CRID>(pool),
+         _db_keys<schema_Toll_ETA, schema_Toll_ETA::CondId>(pool, m_opt.overflow ? _ETA_lane_over_ext : _ETA_lane_over),
+         _db_keys<schema_Toll_Pattern, schema_Toll_Pattern::CondId>(pool),
+      };
+      ok = check.load(loader);
+   }
+   catch(std::exception& e)
+   {
+      CM_LOG_ERROR("%s %s", LOG_HEADER, e.what());
+   }
+
+   auto sel = ok ? m_db->cached_statement("select rowid, CRID, CondID from " TABLE_C ";") : nullptr;
+   ok = nullptr != sel;
+   if ( ok ) 
+   {
+      while ( sel->step_row() )
+      {
+         check.probe(static_cast<size_t>(sel->get_int64(0)), sel->get_text_view(1), sel->get_text_view(2));
+      }
+      sel->reset();
+      check.report();
+   }
+   return ok;
+}
+
+/*!
+ *  \brief  compile the C, CR, Toll_ETA and Toll_Pattern mid files into the
+ *          C-CR-Toll bin directly, without sqlite
+ *
+ *  CR, Toll_ETA and Toll_Pattern are loaded into hash tables keyed by the
+ *  text of CRID and CondID, then C is streamed through them in its file
+ *  order. The bin is the same as the one parsed from the combined db :
+ *   - the CRs of one CRID are kept in their file order, as the table scan;
+ *   - the first Toll row of one CondID is kept, as the unique CondId
+ *     rejects the others.
+ *
+ *  With --validate, the keys of CR, Toll_ETA and Toll_Pattern are loaded by
+ *  CCmValidator ahead, and the rows of C are probed as they are streamed, so
+ *  C is read once. The row of a sample is the line of C.
+ */
+bool CCmDatabase::compile_mid_C_CR_Toll(
+   const char* path_C, 
+   const char* path_CR, 
+   const char* path_Toll_ETA, 
+   const char* path_Toll_Pattern, 
+   const char* bin_path)
+{
+   bool ok = false;
+
+   if ( path_C && path_CR && path_Toll_ETA && path_Toll_Pattern && bin_path ) 
+   {
+      const auto thr = m_opt.threads;
+      typedef schema_C S_C;
+      typedef schema_CR S_CR;
+      typedef schema_Toll_ETA S_ETA;
+      typedef schema_Toll_Pattern S_Ptn;
+      CCmMidReader mid_C(path_C, S_C::FIELD_NUM, thr), mid_CR(path_CR, S_CR::FIELD_NUM, thr);
+      CCmMidReader mid_ETA(path_Toll_ETA, S_ETA::FIELD_NUM, thr), mid_Pattern(path_Toll_Pattern, S_Ptn::FIELD_NUM, thr);
+      CCmBinWriter bin(bin_path, m_opt.big_endian);
+      ok = mid_C.is_open() && mid_CR.is_open() && mid_ETA.is_open() && mid_Pattern.is_open() && bin.is_open();
+      // validate : the keys are loaded ahead, and C is probed as it is streamed
+      std::unique_ptr<CCmValidator> check;
+      if ( ok && m_opt.validate ) 
+      {
+         const CCmValidator::key_load loader[CCmValidator::TABLE_NUM] = {
+            _mid_keys<S_CR, S_CR::CRID>(path_CR),
+            _mid_keys<S_ETA, S_ETA::CondId>(path_Toll_ETA, m_opt.overflow ? _ETA_lane_over_ext : _ETA_lane_over),
+            _mid_keys<S_Ptn, S_Ptn::CondId>(path_Toll_Pattern),
+         };
+         check.reset(new CCmValidator(_C_CR_limit(m_opt.overflow), m_opt.overflow, thr));
+         ok = check->load(loader);
+      }
+      if ( ok ) 
+      {
+         CM_LOG_INFO("%s compile C-CR-Toll to \"%s\" .", LOG_HEADER, bin_path);
+         // build : CR and Toll ETA, with the memos of their texts
+         row_memo memo;
+
+         // the rows of the bad numbers are skipped, as the DB scans do; a bad
+         // ETA or pattern row still takes its CondID, which has none then
+         size_t bad_CR = 0, bad_ETA = 0, bad_Ptn = 0, bad_C = 0;
+
+         // build : CR, by CRID
+         std::unordered_map<std::string, std::vector<CR_RowData>> tab_CR;
+         while (const CCmStrView* field = mid_CR.next())
+         {
+            uint64_t CRID = 0;
+            CR_RowData buf;
+            if ( ! _parse_u64(field[S_CR::CRID], CRID) || ! _CR_row2data(memo, CRID, field[S_CR::VPeriod], field[S_CR::VPDir],
+               field[S_CR::Vehcl_Type], field[S_CR::VP_Approx], buf) )
+            {
+               bad_CR++;
+               continue;
+            }
+            tab_CR[field[S_CR::CRID].str()].push_back(buf);
+         }
+
+         // build : Toll ETA, by CondID
+         struct eta_row
+         {
+            TollETA_RowData data;
+            std::string lane;
+            bool ok;
+         };
+         std::unordered_map<std::string, eta_row> tab_ETA;
+         {
+            CCmArena arena;
+            while (const CCmStrView* field = mid_ETA.next())
+            {
+               auto key = field[S_ETA::CondId].str();
+               if ( tab_ETA.count(key) ) 
+               {
+                  CM_LOG_WARNING("%s[Toll] duplicated Toll ETA CondID %s.", LOG_HEADER, key.c_str());
+                  continue;
+               }
+               eta_row row;
+               CCmStrView lane;
+               uint64_t CondID = 0;
+               row.ok = _parse_u64(field[S_ETA::CondId], CondID) && _TollETA_row2data(arena, memo, CondID, field[S_ETA::TollMode],
+                  field[S_ETA::CardMode], field[S_ETA::TollType], row.data, lane);
+               bad_ETA += row.ok ? 0 : 1;
+               row.lane = lane.str();
+               tab_ETA[key] = row;
+               arena.reset();
+            }
+         }
+
+         // build : Toll pattern, by CondID
+         struct ptn_row
+         {
+            TollPattern_RowData data;
+            bool ok;
+         };
+         std::unordered_map<std::string, ptn_row> tab_Pattern;
+         while (const CCmStrView* field = mid_Pattern.next())
+         {
+            auto key = field[S_Ptn::CondId].str();
+            if ( tab_Pattern.count(key) ) 
+            {
+               CM_LOG_WARNING("%s[Toll] duplicated Toll pattern CondID %s.", LOG_HEADER, key.c_str());
+               continue;
+            }
+            ptn_row row;
+            uint64_t CondID = 0;
+            row.ok = _parse_u64(field[S_Ptn::CondId], CondID)
+               && _TollPattern_row2data(CondID, field[S_Ptn::Pattern], field[S_Ptn::ArrowNo], row.data);
+            bad_Ptn += row.ok ? 0 : 1;
+            tab_Pattern[key] = row;
+         }
+         CM_LOG_INFO("%s CRID %zu, Toll ETA %zu, Toll pattern %zu.", LOG_HEADER, tab_CR.size(), tab_ETA.size(), tab_Pattern.size());
+         memo.report();
+
+         // probe : C
+         uint32_t row_num = 0;
+         size_t bin_size = 0;
+         const char header_zero[sizeof(C_RecHeader)] = {0};
+         auto bin_start = bin.tell();
+         bin.write(header_zero, sizeof(header_zero));
+
+         C_CR_Toll_Record rec;
+         rec.overflow = m_opt.overflow;
+         C_CRDict dict;
+         C_VPSlots slots;
+         C_VehIndex veh;
+         C_RecTables tabs = {m_opt.cr_dict ? &dict : nullptr, m_opt.vp_slots ? &slots : nullptr, m_opt.veh_index ? &veh : nullptr};
+         C_RecTables* ptabs = tabs.empty() ? nullptr : &tabs;
+         CCmRangeOut tile_out(nullptr, bin.big_endian(), true);
+         CCmSpill tiles(m_opt.mem_limit / 2, std::get<0>(parse_path(bin_path)));
+         std::string key;
+         while (const CCmStrView* field = mid_C.next())
+         {
+            const auto& txtCondId   = field[S_C::CondID];
+            const auto& txtInLinkId = field[S_C::inLinkId];
+            const auto& txtOutLinkId= field[S_C::outLinkId];
+            const auto& txtCondType = field[S_C::CondType];
+            const auto& txtCRID     = field[S_C::CRID];
+            if ( check ) {
+               check->probe(mid_C.line_num(), txtCRID, txtCondId);
+            }
+            if ( txtCondId.empty() && txtCRID.empty() ) 
+            {
+               continue;
+            }
+
+            uint64_t InLinkId = 0, OutLinkId = 0, CondType = 0;
+            uint32_t MapID = 0;
+            if ( ( ! txtInLinkId.empty() && ! _parse_u64(txtInLinkId, InLinkId) )
+               || ( ! txtOutLinkId.empty() && ! _parse_u64(txtOutLinkId, OutLinkId) )
+               || ! _parse_u64(txtCondType, CondType) || ( m_opt.tiled && ! _parse_u32(field[S_C::MapID], MapID) ) )
+            {
+               bad_C++;
+               continue;
+            }
+            _C_record_begin(rec, ! txtInLinkId.empty(), InLinkId, ! txtOutLinkId.empty(), OutLinkId, CondType);
+
+            if ( ! txtCRID.empty() ) 
+            {
+               key.assign(txtCRID.data(), txtCRID.size());
+               auto it = tab_CR.find(key);
+               if ( tab_CR.end() != it ) 
+               {
+                  for (const auto& row : it->second)
+                  {
+                     _C_record_add_CR(rec, row);
+                  }
+               }
+               if ( _C_record_end_CR(rec) > 1 )
+               {
+                  CM_LOG_INFO("%s CRID %s, cnt %d. ", LOG_HEADER, key.c_str(), rec.header.cnt_CRID);
+               }
+            }
+
+            if ( ! txtCondId.empty() ) 
+            {
+               key.assign(txtCondId.data(), txtCondId.size());
+               auto it_ETA = tab_ETA.find(key);
+               if ( tab_ETA.end() != it_ETA && it_ETA->second.ok ) 
+               {
+                  _C_record_set_ETA(rec, it_ETA->second.data, it_ETA->second.lane);
+               }
+               auto it_Pattern = tab_Pattern.find(key);
+               if ( tab_Pattern.end() != it_Pattern && it_Pattern->second.ok ) 
+               {
+                  _C_record_set_pattern(rec, it_Pattern->second.data);
+               }
+            }
+
+            if ( m_opt.tiled ) {
+               tile_out.tile(MapID);
+               _C_record_write(tile_out, rec, nullptr);
+               _tiles_add(tiles, tile_out);
+            }
+            else {
+               bin_size += _C_record_write(bin, rec, ptabs);
+            }
+            if ( ++row_num % 100 == 0 )
+            {
+               CM_LOG_INFO("%s stepped %d rows", LOG_HEADER, row_num);
+            }
+         }
+
+         if ( bad_CR + bad_ETA + bad_Ptn + bad_C > 0 )
+         {
+            CM_LOG_WARNING("%s %zu CR, %zu Toll ETA, %zu Toll pattern and %zu C rows skipped for the bad numbers.",
+               LOG_HEADER, bad_CR, bad_ETA, bad_Ptn, bad_C);
+         }
+
+         ok = true;
+         if ( m_opt.tiled ) {
+            ok = _tiles_write(bin, tiles, [&](const char* p, size_t n){
+               bin_size += _C_record_copy(bin, p, n, rec, ptabs);
+            });
+         }
+         _C_tables_write(bin, tabs);
+         ok = ok && _C_CR_Toll_header(bin, bin_start, row_num, bin_size, tabs, m_opt.tiled, m_opt.overflow) && bin.close();
+         if ( check ) {
+            check->report();
+         }
+      }
+      else
+      {
+         CM_LOG_WARNING("%s open mid files or \"%s\" failed!", LOG_HEADER, bin_path);
+      }
+   }
+   else 
+   {
+      CM_LOG_ERROR("%s illegal parameter C : %s, CR : %s, Toll ETA : %s, Toll Pattern : %s, output bin path : %s", 
+         LOG_HEADER, path_C, path_CR, path_Toll_ETA, path_Toll_Pattern, bin_path);
+   }
+
+   return ok;
+}
+
+bool CCmDatabase::do_argv(std::vector<std::string> &v)
+{
+   //CM_LOG_INFO("%s the number of arguments is %d.", LOG_HEADER, v.size());
+   bool ok = false;
+
+   std::vector<std::tuple<std::string, std::string, std::string>> vecMid, vecDB;
+   for(const auto& arg : v)
+   {
+      std::string dir, bname, ext;
+      std::tie(dir, bname, ext) = parse_path(arg);
+      if ( "mid" == ext ) {
+         vecMid.push_back(std::make_tuple(dir, bname, arg));
+      }
+      else if ( "db" == ext ) {
+         vecDB.push_back(std::make_tuple(dir, bname, arg));
+      }
+   }
+
+   if( ! vecMid.empty() && ! vecDB.empty())
+   {
+      CM_LOG_WARNING("do on not know what to do!", LOG_HEADER);
+   }
+   else if( ! vecMid.empty())
+   {
+      std::string mid_dir;
+      auto& dst = vecMid[0];
+      if(std::all_of(vecMid.begin(), vecMid.end(), [&dst](decltype(dst)& src){return std::get<0>(src) == std::get<0>(dst);}))
+      {
+         std::tie(mid_dir, std::ignore, std::ignore) = dst;
+      }
+
+      if( 1 == vecMid.size())
+      {
+         std::string mid_path;
+         std::tie(std::ignore, std::ignore, mid_path) = dst;
+         ok = import_mid(mid_path.c_str());
+      }
+
+#if  0     /* ----- #if 0 : If0Label_1 ----- */
+      else if( 2 == vecMid.size())
+      {
+         //ok = im
+      }
+#endif     /* ----- #if 0 : If0Label_1 ----- */
+      else if( 4 == vecMid.size())
+      {
+         std::string path[4], province;
+         if ( _match_C_CR_Toll(vecMid, path, province) ) 
+         {
+            std::string bin_path = province + "_C_CR_Toll.bin";
+            if( ! mid_dir.empty())
+            {
+               bin_path = mid_dir + '/' + bin_path;
+            }
+            ok = compile_mid_C_CR_Toll(path[0].c_str(), path[1].c_str(), path[2].c_str(), path[3].c_str(), bin_path.c_str());
+
+            // the db files are for debug only
+            for (size_t i = 0; ok && m_opt.keep_db && i < 4; ++i)
+            {
+               CCmDatabase db(m_opt);
+               ok = db.import_mid(path[i].c_str());
+            }
+         }
+         else
+         {
+            CM_LOG_WARNING("%s checking failed!", LOG_HEADER);
+         }
+      }
+
+      else
+      {
+         CM_LOG_WARNING("%s unexpected the number(%d) of mid files!", LOG_HEADER, vecMid.size());
+      }
+   }
+   else if( ! vecDB.empty())
+   {
+      std::string out_dir;
+      auto& dst = vecDB[0];
+      if(std::all_of(vecDB.begin(), vecDB.end(), [&dst](decltype(dst)& src){return std::get<0>(src) == std::get<0>(dst);}))
+      {
+         std::tie(out_dir, std::ignore, std::ignore) = dst;
+      }
+
+      //CM_LOG_INFO("%s DB number : %d, out dir : %s.", LOG_HEADER, vecDB.size(), out_dir.c_str());
+      if( 1 == vecDB.size())
+      {
+         std::string db_path;
+         std::tie(std::ignore, std::ignore, db_path) = dst;
+         ok = parse_db(db_path.c_str());
+      }
+      else if( 2 == vecDB.size())
+      {
+         std::string path_C, path_CR;
+         std::string prvnc_C, prvnc_CR;
+         for(auto& e : vecDB)
+         {
+            std::string basname, db_path, m;
+            std::tie(std::ignore, basname, db_path) = e;
+            auto k = _bname_kind(basname, &m);
+
+            //CM_LOG_INFO("%s the DB base name \"%s\".", LOG_HEADER, basname.c_str());
+            if ( path_C.empty() && BNAME_C == k ) {
+               path_C = db_path;
+               prvnc_C = m;
+            }
+            else if ( path_CR.empty() && BNAME_CR == k ) {
+               path_CR = db_path;
+               prvnc_CR = m;
+            }
+         }
+
+         //CM_LOG_INFO("%s province C : \"%s\", province CR : \"%s\".", LOG_HEADER, prvnc_C.c_str(), prvnc_CR.c_str());
+         if((prvnc_CR == prvnc_C) && ! path_CR.empty() && ! path_C.empty())
+         {
+            std::string db_path = prvnc_C + "_C_CR.db";
+            if( ! out_dir.empty())
+            {
+               db_path = out_dir + '/' + db_path;
+            }
+            ok = combine_db_C_CR(path_C.c_str(), path_CR.c_str(),  db_path.c_str());
+         }
+      }
+      else if( 4 == vecDB.size())
+      {
+         std::string path[4], province;
+         if ( _match_C_CR_Toll(vecDB, path, province) ) 
+         {
+            std::string db_path = province + "_C_CR_Toll.db";
+            if( ! out_dir.empty())
+            {
+               db_path = out_dir + '/' + db_path;
+            }
+            ok = combine_db_C_CR_Toll(path[0].c_str(), path[1].c_str(), path[2].c_str(), path[3].c_str(), db_path.c_str());
+         }
+         else
+         {
+            CM_LOG_WARNING("%s checking failed!", LOG_HEADER);
+         }
+      }
+      else
+      {
+         CM_LOG_WARNING("%s unexpected the number(%d) of DB files!", LOG_HEADER, vecDB.size());
+      }
+   }
+   else
+   {
+      CM_LOG_WARNING("%s No input available!!", LOG_HEADER);
+   }
+
+   return ok;
+}
@@ -0,0 +1,344 @@
+/*!
+ *    \file  cm_mid.cpp
+ *   \brief  mid file reader implement
+ *
+ *  the mid lines are split into fields by chunks on the threads, and handed
+ *  out in the file order.
+ *
+ *  \author  Wang Xiaolong (WXL), wangxl3@mapbar.com
+ *
+ *  \internal
+ *       Created:  10/19/2026
+ *      Revision:  none
+ *      Compiler:  gcc
+ *  Organization:  mapbar co.
+ *     Copyright:  mapbar
+ *
+ *  This source code is released for free distribution under the terms of the
+ *  GNU General Public License as published by the Free Software Foundation.
+ */
+
+//-----------------------------------------------------------------------------
+//  Header Section
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include "cm_mid.hpp"
+#include "cm_scan.hpp"
+#include "cm_debug.h"
+
+//-----------------------------------------------------------------------------
+//  MACRO Defination
+//-----------------------------------------------------------------------------
+#define LOG_HEADER "[CM_MID]"
+
+//-----------------------------------------------------------------------------
+//  Class CCmMidReader Implement Section
+//-----------------------------------------------------------------------------
+CCmMidReader::CCmMidReader(const char* path, size_t fldnum, size_t threads, size_t blksiz)
+: m_file(path, std::ios::binary)
+, m_fldnum(fldnum)
+, m_threads(std::max<size_t>(threads, 1))
+, m_blksiz(std::max<size_t>(blksiz, 1))
+, m_cur(0)
+, m_chunk(0)
+, m_line(0)
+, m_count(0)
+, m_lineno(0)
+, m_last(fldnum)
+, m_carry(fldnum)
+{
+   m_blk[0].last = m_blk[1].last = true;
+   if ( m_fldnum > 255 )
+   {
+      CM_LOG_ERROR("%s too many fields %zu!", LOG_HEADER, m_fldnum);
+      m_file.close();
+   }
+
+   if ( m_file.is_open() )
+   {
+      load(m_blk[m_cur]);
+      start();
+   }
+}
+
+CCmMidReader::~CCmMidReader()
+{
+   finish();
+}
+
+/*!
+ *  \brief  the fields of the next line
+ *  \return fldnum fields, or nullptr at the end of the file
+ *
+ *  The fields are valid until the next call. count() is the number of the
+ *  fields in the line, the others are taken from the previous lines.
+ */
+const CCmStrView* CCmMidReader::next()
+{
+   while ( m_file.is_open() )
+   {
+      auto& blk = m_blk[m_cur];
+      if ( m_chunk < blk.chunks.size() )
+      {
+         auto& c = blk.chunks[m_chunk];
+         if ( m_line < c.count.size() )
+         {
+            CCmStrView* field = &c.field[m_line * m_fldnum];
+            m_count = c.count[m_line++];
+            for (size_t i = m_count; i < m_fldnum; ++i)
+            {
+               field[i] = m_last[i];
+            }
+            std::copy(field, field + m_fldnum, m_last.begin());
+            m_lineno++;
+            return field;
+         }
+
+         m_chunk++;
+         m_line = 0;
+         continue;
+      }
+
+      if ( blk.last )
+      {
+         break;
+      }
+
+      // the block is over, hand out the other one
+      finish();
+      carry();
+      m_cur ^= 1;
+      m_chunk = 0;
+      m_line = 0;
+      start();
+   }
+
+   m_count = 0;
+   return nullptr;
+}
+
+/*!
+ *  \brief  read the next whole lines into the block and split them
+ *
+ *  The block is divided into m_threads chunks at the line ends, the first
+ *  chunk is split on the calling thread.
+ */
+void CCmMidReader::load(block& b)
+{
+   b.buf.swap(m_tail);
+   m_tail.clear();
+   b.last = false;
+
+   size_t eol = std::string::npos;
+   while ( std::string::npos == eol && ! b.last )
+   {
+      size_t pos = b.buf.size();
+      b.buf.resize(pos + m_blksiz);
+      m_file.read(&b.buf[pos], m_blksiz);
+      size_t got = static_cast<size_t>(m_file.gcount());
+      b.buf.resize(pos + got);
+      b.last = got < m_blksiz;
+      eol = b.buf.rfind('\n');
+   }
+
+   if ( ! b.last && std::string::npos != eol )
+   {
+      m_tail.assign(b.buf, eol + 1, std::string::npos);
+      b.buf.resize(eol + 1);
+   }
+
+   const char* begin = b.buf.data();
+   const char* end = begin + b.buf.size();
+   b.chunks.resize(m_threads);
+   for (size_t i = 0; i < m_threads; ++i)
+   {
+      auto& c = b.chunks[i];
+      c.begin = (0 == i) ? begin : b.chunks[i - 1].end;
+      c.end = end;
+      if ( i + 1 < m_threads )
+      {
+         const char* split = std::max(c.begin, begin + b.buf.size() / m_threads * (i + 1));
+         c.end = std::find(split, end, '\n');
+         c.end = (end == c.end) ? end : c.end + 1;
+      }
+   }
+
+   std::vector<std::thread> workers;
+   for (size_t i = 1; i < m_threads; ++i)
+   {
+      workers.push_back(std::thread(&CCmMidReader::split, this, std::ref(b.chunks[i])));
+   }
+   split(b.chunks[0]);
+   for (auto& w : workers)
+   {
+      w.join();
+   }
+}
+
+/*!
+ *  \brief  split the lines of the chunk into the fields, as std::getline() with ','
+ *
+ *  The chunk is scanned into the masks of comma, quote and line end by 64
+ *  bytes, then the commas and the line ends are walked in order. The first
+ *  and the last quotes of a field are taken from the quote mask between
+ *  them, for stripping the quotes.
+ */
+void CCmMidReader::split(chunk& c) const
+{
+   c.field.clear();
+   c.count.clear();
+
+   const char* base = c.begin;
+   const size_t size = c.end - c.begin;
+   const size_t none = static_cast<size_t>(-1);
+
+   size_t n = 0;                       // fields of the line
+   size_t line = c.field.size();       // first field of the line
+   size_t start = 0;                   // start of the field
+   size_t fq = none, lq = none;        // first and last quotes of the field
+   bool skip = false;                  // fields exceeded, skip to the line end
+   c.field.resize(line + m_fldnum);
+
+   // the field [start, pos), without the quotes
+   auto piece = [&](size_t pos)
+   {
+      size_t b = start, e = pos;
+      if ( none != fq )
+      {
+         b = fq + 1;
+         e = ( lq > fq ) ? lq : pos;
+      }
+      return CCmStrView(base + b, e - b);
+   };
+
+   auto add = [&](size_t pos)
+   {
+      if ( n < m_fldnum )
+      {
+         c.field[line + n++] = piece(pos);
+      }
+      else
+      {
+         CM_LOG_WARNING("%s field number(%zu) exceeded!", LOG_HEADER, n + 1);
+         skip = true;
+      }
+   };
+
+   auto end_line = [&](size_t pos)
+   {
+      // the '\r' of the CRLF line end is not in the last field
+      size_t end = ( pos > start && '\r' == base[pos - 1] ) ? pos - 1 : pos;
+      // the last empty field is dropped, as the empty line
+      if ( ! skip && end > start )
+      {
+         add(end);
+      }
+      if ( n > 0 )
+      {
+         c.count.push_back(static_cast<unsigned char>(n));
+         line = c.field.size();
+         c.field.resize(line + m_fldnum);
+      }
+      n = 0;
+      skip = false;
+      start = pos + 1;
+      fq = lq = none;
+   };
+
+   // the first and the last quotes of the mask into fq and lq
+   auto quote = [&](size_t word, uint64_t q)
+   {
+      if ( q )
+      {
+         fq = ( none == fq ) ? word + cm_ctz64(q) : fq;
+         lq = word + 63 - cm_clz64(q);
+      }
+   };
+
+   CCmScanMask m;
+   for (size_t word = 0; word < size; word += 64)
+   {
+      cm_scan(base + word, size - word, m);
+      uint64_t bits = m.comma | m.eol;
+      if ( size - word < 64 )
+      {
+         bits &= (uint64_t(1) << (size - word)) - 1;
+      }
+
+      uint64_t from = ~uint64_t(0);    // the bits of the field in the word
+      while ( bits )
+      {
+         size_t i = cm_ctz64(bits);
+         uint64_t bit = bits & (0 - bits);
+         bits ^= bit;
+         size_t pos = word + i;
+
+         if ( ! skip )
+         {
+            quote(word, m.quote & from & (bit - 1));
+         }
+         from = ~((bit << 1) - 1);
+
+         if ( m.eol & bit )
+         {
+            end_line(pos);
+         }
+         else if ( ! skip )
+         {
+            add(pos);
+            start = pos + 1;
+            fq = lq = none;
+         }
+      }
+
+      if ( ! skip )
+      {
+         quote(word, m.quote & from);
+      }
+   }
+
+   // the last line without the line end
+   if ( start < size || n > 0 )
+   {
+      end_line(size);
+   }
+   c.field.resize(line);
+}
+
+/// \brief load the other block, on the loader thread if there are threads
+void CCmMidReader::start()
+{
+   if ( ! m_blk[m_cur].last )
+   {
+      auto& other = m_blk[m_cur ^ 1];
+      if ( m_threads > 1 )
+      {
+         m_loader = std::thread(&CCmMidReader::load, this, std::ref(other));
+      }
+      else
+      {
+         load(other);
+      }
+   }
+}
+
+void CCmMidReader::finish()
+{
+   if ( m_loader.joinable() )
+   {
+      m_loader.join();
+   }
+}
+
+/// \brief copy the fields of the previous line out of the block handed out
+void CCmMidReader::carry()
+{
+   for (size_t i = 0; i < m_fldnum; ++i)
+   {
+      if ( m_last[i].data() != m_carry[i].data() )
+      {
+         m_carry[i].assign(m_last[i].data(), m_last[i].size());
+      }
+      m_last[i] = CCmStrView(m_carry[i]);
+   }
+}
@@ -0,0 +1,154 @@
+/*!
+ *    \file  cm_scan.cpp
+ *   \brief  structural character scanner of the mid text
+ *
+ *  The comma, quote and line end of 64 bytes are compared at once into bit
+ *  masks, by AVX2 or SSE2 if the CPU has them, otherwise byte by byte. The
+ *  kernel is chosen once when the program starts.
+ *
+ *  \author  Wang Xiaolong (WXL), wangxl3@mapbar.com
+ *
+ *  \internal
+ *       Created:  10/19/2026
+ *      Revision:  none
+ *      Compiler:  gcc
+ *  Organization:  mapbar co.
+ *     Copyright:  mapbar
+ *
+ *  This source code is released for free distribution under the terms of the
+ *  GNU General Public License as published by the Free Software Foundation.
+ */
+
+//-----------------------------------------------------------------------------
+//  Header Section
+//-----------------------------------------------------------------------------
+#include <cstring>
+#include "cm_scan.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CM_SCAN_X86 1
+#include <immintrin.h>
+#else
+#define CM_SCAN_X86 0
+#endif
+
+//-----------------------------------------------------------------------------
+//  Local Utility
+//-----------------------------------------------------------------------------
+static void _scan_scalar(const char* p, CCmScanMask& m)
+{
+   m.comma = m.quote = m.eol = 0;
+   for (size_t i = 0; i < 64; ++i)
+   {
+      uint64_t bit = uint64_t(1) << i;
+      switch(p[i])
+      {
+         case ',':
+            m.comma |= bit;
+            break;
+         case '\"':
+            m.quote |= bit;
+            break;
+         case '\n':
+            m.eol |= bit;
+            break;
+         default:
+            break;
+      }
+   }
+}
+
+#if CM_SCAN_X86
+__attribute__((target("sse2")))
+static void _scan_sse2(const char* p, CCmScanMask& m)
+{
+   const __m128i comma = _mm_set1_epi8(',');
+   const __m128i quote = _mm_set1_epi8('\"');
+   const __m128i eol = _mm_set1_epi8('\n');
+
+   m.comma = m.quote = m.eol = 0;
+   for (size_t i = 0; i < 64; i += 16)
+   {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+      m.comma |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, comma)))) << i;
+      m.quote |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)))) << i;
+      m.eol   |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, eol)))) << i;
+   }
+}
+
+__attribute__((target("avx2")))
+static inline uint64_t _mask_avx2(__m256i lo, __m256i hi, __m256i c)
+{
+   uint64_t ml = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, c)));
+   uint64_t mh = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, c)));
+   return ml | (mh << 32);
+}
+
+__attribute__((target("avx2")))
+static void _scan_avx2(const char* p, CCmScanMask& m)
+{
+   __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+   __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+   m.comma = _mask_avx2(lo, hi, _mm256_set1_epi8(','));
+   m.quote = _mask_avx2(lo, hi, _mm256_set1_epi8('\"'));
+   m.eol   = _mask_avx2(lo, hi, _mm256_set1_epi8('\n'));
+}
+#endif
+
+static cm_scan_fn _select(const char*& isa)
+{
+   isa = "scalar";
+   cm_scan_fn fn = _scan_scalar;
+#if CM_SCAN_X86
+   __builtin_cpu_init();
+   if ( __builtin_cpu_supports("avx2") )
+   {
+      isa = "avx2";
+      fn = _scan_avx2;
+   }
+   else if ( __builtin_cpu_supports("sse2") )
+   {
+      isa = "sse2";
+      fn = _scan_sse2;
+   }
+#endif
+   return fn;
+}
+
+static const char* g_isa = nullptr;
+static const cm_scan_fn g_kernel = _select(g_isa);
+
+//-----------------------------------------------------------------------------
+//  Interface Implement Section
+//-----------------------------------------------------------------------------
+/// \brief the kernel for 64 bytes, chosen by the CPU
+cm_scan_fn cm_scan_kernel()
+{
+   return g_kernel;
+}
+
+/// \brief the instruction set of the kernel, "avx2", "sse2" or "scalar"
+const char* cm_scan_isa()
+{
+   return g_isa;
+}
+
+/*!
+ *  \brief  scan up to 64 bytes into the masks
+ *
+ *  The bytes less than 64 are scanned in a copy padded by zero, so nothing
+ *  after them is read.
+ */
+void cm_scan(const char* p, size_t n, CCmScanMask& m)
+{
+   if ( n >= 64 )
+   {
+      g_kernel(p, m);
+   }
+   else
+   {
+      char buf[64] = {0};
+      std::memcpy(buf, p, n);
+      g_kernel(buf, m);
+   }
+}
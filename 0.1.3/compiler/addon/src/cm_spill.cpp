@@ -0,0 +1,229 @@
+/*!
+ *    \file  cm_spill.cpp
+ *   \brief  external merge sort implement
+ *
+ *  the records over the memory limit are sorted into the runs of the spill
+ *  files, which are merged at last.
+ *
+ *  \author  Wang Xiaolong (WXL), wangxl3@mapbar.com
+ *
+ *  \internal
+ *       Created:  10/19/2026
+ *      Revision:  none
+ *      Compiler:  gcc
+ *  Organization:  mapbar co.
+ *     Copyright:  mapbar
+ *
+ *  This source code is released for free distribution under the terms of the
+ *  GNU General Public License as published by the Free Software Foundation.
+ */
+
+//-----------------------------------------------------------------------------
+//  Header Section
+//-----------------------------------------------------------------------------
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <queue>
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+#include "cm_spill.hpp"
+#include "cm_debug.h"
+
+//-----------------------------------------------------------------------------
+//  MACRO Defination
+//-----------------------------------------------------------------------------
+#define LOG_HEADER "[CM_SPILL]"
+
+//-----------------------------------------------------------------------------
+//  Constants Defination
+//-----------------------------------------------------------------------------
+static const size_t RUN_BUFSIZ = 256 * 1024;   ///< the stdio buffer of a run
+
+//-----------------------------------------------------------------------------
+//  Local Utility
+//-----------------------------------------------------------------------------
+/// \brief read the next record of the run, false at its end
+static bool _read_record(FILE* f, uint32_t& key, std::string& rec)
+{
+   uint32_t head[2];
+   if ( 1 != fread(head, sizeof(head), 1, f) )
+   {
+      return false;
+   }
+   key = head[0];
+   rec.resize(head[1]);
+   return 0 == head[1] || 1 == fread(&rec[0], head[1], 1, f);
+}
+
+//-----------------------------------------------------------------------------
+//  Class CCmSpill Implement Section
+//-----------------------------------------------------------------------------
+CCmSpill::CCmSpill(size_t limit, const std::string& dir)
+: m_limit(limit)
+, m_dir(dir.empty() ? std::string(".") : dir)
+, m_ok(true)
+, m_count(0)
+, m_spilled(0)
+{
+}
+
+CCmSpill::~CCmSpill()
+{
+   for (auto f : m_run)
+   {
+      fclose(f);
+   }
+}
+
+/// \brief add the record of the key, the records in memory are spilled as a run at the limit
+void CCmSpill::add(uint32_t key, const void* p, size_t n)
+{
+   item e = {key, static_cast<uint32_t>(n), m_buf.size()};
+   m_buf.append(static_cast<const char*>(p), n);
+   m_item.push_back(e);
+   m_keys[key]++;
+   m_count++;
+   if ( m_limit > 0 && m_buf.size() + m_item.size() * sizeof(item) >= m_limit )
+   {
+      spill();
+   }
+}
+
+/*!
+ *  \brief  give all the records to put(key, p, n) in the order of the key
+ *
+ *  The records in memory are the last run. The runs are merged by a heap of
+ *  their next records, and the ones of the same key are taken from the
+ *  earlier run first, so the order they are added is kept.
+ */
+bool CCmSpill::merge(const record_put& put)
+{
+   sort();
+   if ( m_run.empty() )
+   {
+      for (const auto& e : m_item)
+      {
+         put(e.key, m_buf.data() + e.pos, e.size);
+      }
+      return m_ok;
+   }
+
+   const size_t mem = m_run.size();
+   std::vector<std::string> rec(mem);
+   std::vector<uint32_t> key(mem);
+   size_t next = 0;                       ///< of the records in memory
+   auto pull = [&](size_t r){
+      if ( r < mem ) {
+         return _read_record(m_run[r], key[r], rec[r]);
+      }
+      return next < m_item.size();
+   };
+
+   typedef std::pair<uint32_t, size_t> head;
+   std::priority_queue<head, std::vector<head>, std::greater<head>> heap;
+   for (size_t r = 0; m_ok && r < mem; ++r)
+   {
+      rewind(m_run[r]);
+      if ( pull(r) ) {
+         heap.push(head(key[r], r));
+      }
+   }
+   if ( pull(mem) ) {
+      heap.push(head(m_item[next].key, mem));
+   }
+
+   while ( m_ok && ! heap.empty() )
+   {
+      size_t r = heap.top().second;
+      heap.pop();
+      if ( r < mem ) {
+         put(key[r], rec[r].data(), rec[r].size());
+      }
+      else {
+         const auto& e = m_item[next++];
+         put(e.key, m_buf.data() + e.pos, e.size);
+      }
+
+      if ( pull(r) ) {
+         heap.push(head(r < mem ? key[r] : m_item[next].key, r));
+      }
+      else if ( r < mem && ferror(m_run[r]) ) {
+         CM_LOG_ERROR("%s read the run %zu failed!", LOG_HEADER, r);
+         m_ok = false;
+      }
+   }
+
+   CM_LOG_INFO("%s %zu records merged from %zu runs, %llu bytes spilled.", LOG_HEADER, m_count, mem + 1,
+      static_cast<unsigned long long>(m_spilled));
+   return m_ok;
+}
+
+/// \brief sort the records in memory by the key, those of the same key keep their order
+void CCmSpill::sort()
+{
+   std::stable_sort(m_item.begin(), m_item.end(), [](const item& a, const item& b){
+      return a.key < b.key;
+   });
+}
+
+/// \brief write the records in memory sorted as a run, {key, size} and the bytes of each
+bool CCmSpill::spill()
+{
+   FILE* f = m_ok ? open_run() : nullptr;
+   if ( f )
+   {
+      sort();
+      for (const auto& e : m_item)
+      {
+         uint32_t head[2] = {e.key, e.size};
+         fwrite(head, sizeof(head), 1, f);
+         fwrite(m_buf.data() + e.pos, e.size, 1, f);
+      }
+      m_ok = 0 == fflush(f) && ! ferror(f);
+      m_spilled += m_buf.size() + 2 * sizeof(uint32_t) * m_item.size();
+      if ( ! m_ok )
+      {
+         CM_LOG_ERROR("%s write the run %zu failed, %s!", LOG_HEADER, m_run.size() - 1, std::strerror(errno));
+      }
+   }
+
+   m_buf.clear();
+   m_item.clear();
+   return m_ok;
+}
+
+/// \brief open a new run, the file is removed at once and gone as it is closed
+FILE* CCmSpill::open_run()
+{
+   FILE* f = nullptr;
+#if defined(__linux__)
+   std::string path = m_dir + "/cm_spill_XXXXXX";
+   int fd = mkstemp(&path[0]);
+   if ( fd >= 0 )
+   {
+      unlink(path.c_str());
+      f = fdopen(fd, "w+b");
+      if ( nullptr == f )
+      {
+         close(fd);
+      }
+   }
+#else
+   f = tmpfile();
+#endif
+
+   if ( f )
+   {
+      m_vbuf.emplace_back(RUN_BUFSIZ);
+      setvbuf(f, m_vbuf.back().data(), _IOFBF, RUN_BUFSIZ);
+      m_run.push_back(f);
+   }
+   else
+   {
+      CM_LOG_ERROR("%s open the spill file in \"%s\" failed, %s!", LOG_HEADER, m_dir.c_str(), std::strerror(errno));
+      m_ok = false;
+   }
+   return f;
+}
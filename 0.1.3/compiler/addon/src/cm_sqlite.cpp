@@ -1,226 +1,510 @@
-/*!
- *    \file  cm_sqlite.cpp
- *   \brief  sqilte wrapper implement
- *  
- *  wrapper create table, statement step etc.
- *  
- *  \author  Wang Xiaolong (WXL), wangxl3@mapbar.com
- *  
- *  \internal
- *       Created:  11/28/2016
- *      Revision:  none
- *      Compiler:  gcc
- *  Organization:  mapbar co.
- *     Copyright:  mapbar
- *  
- *  This source code is released for free distribution under the terms of the
- *  GNU General Public License as published by the Free Software Foundation.
- */
-
-/*!
- *  \page cm_sqlite sqlite wrapper
- *  some detail for sqlite wrapper
- */
-//-----------------------------------------------------------------------------
-//  Header Section
-//-----------------------------------------------------------------------------
-#include <cstdlib>
-#include <algorithm>
-#include <stdexcept>
-#include <sstream>
-#include "cm_sqlite.hpp"
-#include "cm_debug.h"
-
-//-----------------------------------------------------------------------------
-//  Macro Defination Section
-//-----------------------------------------------------------------------------
-#define LOG_HEADER "[CM_SQLITE]"
-
-//-----------------------------------------------------------------------------
-//  Class CCmSqlite Implement Section
-//-----------------------------------------------------------------------------
-CCmSqlite::CCmSqlite(const char* path)
-{
-   int rc = sqlite3_open_v2(path, &m_db, SQLITE_OPEN_CREATE | SQLITE_OPEN_READWRITE, NULL);
-   if (SQLITE_OK != rc)
-   {
-      std::ostringstream os;
-      os << "open db error! bad database path : " << path;
-      throw std::logic_error(os.str());
-   }
-}
-
-CCmSqlite::~CCmSqlite()
-{
-   for (auto e : m_stmt)
-   {
-      if (e)
-      {
-         delete e;
-      }
-   }
-}
-
-bool CCmSqlite::execute(const char* sql)
-{
-   bool ok = true;
-   char* err = NULL;
-   int rc = sqlite3_exec(m_db, sql, NULL, NULL, &err);
-   if (SQLITE_OK != rc)
-   {
-      if (NULL != err)
-      {
-         CM_LOG_ERROR("%s failed to execute : %s by excute %s!", LOG_HEADER, err, sql);
-         sqlite3_free(err);
-      }
-
-      ok = false;
-   }
-
-   return ok;
-}
-
-CCmSqlite::statement* CCmSqlite::create_statement(const char* s)
-{
-   statement* stmt = nullptr;
-   try
-   {
-      stmt = new statement(m_db, s);
-   }
-   catch(std::exception& e)
-   {
-      CM_LOG_ERROR("%p %s\n", stmt, e.what());
-   }
-
-   if (stmt)
-   {
-      m_stmt.push_back(stmt);
-   }
-
-   return stmt;
-}
-
-void CCmSqlite::remove_statement(CCmSqlite::statement* s)
-{
-   if ( s ) 
-   {
-      //CM_LOG_INFO("%s remove statement pointer %p", LOG_HEADER, s);
-      auto pos = std::remove(m_stmt.begin(), m_stmt.end(), s);
-      if ( m_stmt.end() != pos )
-      {
-         m_stmt.pop_back();
-      }
-   }
-}
-
-bool CCmSqlite::backup(const char* path)
-{
-   bool ok = false;
-   if(path)
-   {
-      sqlite3* dst_db = nullptr;
-      int rc = sqlite3_open_v2(path, &dst_db, SQLITE_OPEN_CREATE | SQLITE_OPEN_READWRITE, NULL);
-      if (SQLITE_OK == rc)
-      {
-         sqlite3_backup* bak = sqlite3_backup_init(dst_db, "main", m_db, "main");
-         if ( bak ) 
-         {
-            sqlite3_backup_step(bak, -1);
-            sqlite3_backup_finish(bak);
-            ok = true;
-         }
-         else
-         {
-            CM_LOG_WARNING("%s backup destinate path \"%s\" initialize failed!", LOG_HEADER, path);
-         }
-      }
-      else
-      {
-         CM_LOG_WARNING("%s backup destinate path \"%s\" open failed!", LOG_HEADER, path);
-      }
-   }
-   else
-   {
-      CM_LOG_WARNING("%s backup null path!", LOG_HEADER);
-   }
-
-   return ok;
-}
-
-bool CCmSqlite::attach(const char* path, const char* alias)
-{
-   bool ok = false;
-   if ( path && alias ) {
-      std::string sql = std::string("attach database \'") + path + "\' as " + alias + ";";
-      ok = execute(sql.c_str());
-   }
-   return ok;
-}
-
-bool CCmSqlite::detach(const char* db)
-{
-   bool ok = false;
-   if ( db ) {
-      std::string sql = std::string("detach database ") + db + ";";
-      ok = execute(sql.c_str());
-   }
-   return ok;
-}
-//-----------------------------------------------------------------------------
-//  Class CCmSqlite::statement Implement Section
-//-----------------------------------------------------------------------------
-CCmSqlite::statement::statement(sqlite3* db, const char* s) : m_sql(s)
-{
-   int rc = sqlite3_prepare(db, s, -1, &m_stmt, NULL);
-   if (SQLITE_OK != rc)
-   {
-      std::ostringstream os;
-      os << "statement prepared error! The statement is \"" << s <<"\". " << sqlite3_errmsg(db);
-      throw std::logic_error(os.str());
-   }
-}
-
-CCmSqlite::statement::~statement()
-{
-   sqlite3_finalize(m_stmt);
-}
-
-bool CCmSqlite::statement::step()
-{
-   bool ok = false;
-   int rc = sqlite3_step(m_stmt);
-   if (SQLITE_OK == rc)
-   {
-      ok = true;
-   }
-
-   return ok;
-}
-
-bool CCmSqlite::statement::step_row()
-{
-   bool row = false;
-   int rc = sqlite3_step(m_stmt);
-   if (SQLITE_ROW == rc)
-   {
-      row = true;
-   }
-
-   return row;
-}
-
-const char* CCmSqlite::statement::get_text(size_t pos)
-{
-   return reinterpret_cast<const char*>(sqlite3_column_text(m_stmt, pos));
-}
-
-bool CCmSqlite::statement::bind_text(size_t pos, const char* s)
-{
+/*!
+ *    \file  cm_sqlite.cpp
+ *   \brief  sqilte wrapper implement
+ *  
+ *  wrapper create table, statement step etc.
+ *  
+ *  \author  Wang Xiaolong (WXL), wangxl3@mapbar.com
+ *  
+ *  \internal
+ *       Created:  11/28/2016
+ *      Revision:  none
+ *      Compiler:  gcc
+ *  Organization:  mapbar co.
+ *     Copyright:  mapbar
+ *  
+ *  This source code is released for free distribution under the terms of the
+ *  GNU General Public License as published by the Free Software Foundation.
+ */
+
+/*!
+ *  \page cm_sqlite sqlite wrapper
+ *  some detail for sqlite wrapper
+ */
+//-----------------------------------------------------------------------------
+//  Header Section
+//-----------------------------------------------------------------------------
+#include <cstdlib>
+#include <algorithm>
+#include <stdexcept>
+#include <sstream>
+#include "cm_sqlite.hpp"
+#include "cm_debug.h"
+
+//-----------------------------------------------------------------------------
+//  Macro Defination Section
+//-----------------------------------------------------------------------------
+#define LOG_HEADER "[CM_SQLITE]"
+
+//-----------------------------------------------------------------------------
+//  Constants Defination
+//-----------------------------------------------------------------------------
+static const char* MMAP_PRAGMA = "pragma mmap_size = 1073741824;";   ///< 1GB of the read only DB mapped
+
+//-----------------------------------------------------------------------------
+//  Class CCmSqlite Implement Section
+//-----------------------------------------------------------------------------
+/*!
+ *  \brief  open the DB
+ *
+ *  The read only DB is not created if it does not exist, and its pages are
+ *  read through the memory map instead of copied into the page cache.
+ */
+CCmSqlite::CCmSqlite(const char* path, bool readonly) : m_profile(false)
+{
+   // URI for the shared cache memory DB, see combine_db_C_CR_Toll
+   int flags = readonly ? SQLITE_OPEN_READONLY : (SQLITE_OPEN_CREATE | SQLITE_OPEN_READWRITE);
+   int rc = sqlite3_open_v2(path, &m_db, flags | SQLITE_OPEN_URI, NULL);
+   if (SQLITE_OK != rc)
+   {
+      sqlite3_close(m_db);
+      std::ostringstream os;
+      os << "open db error! bad database path : " << path;
+      throw std::logic_error(os.str());
+   }
+
+   if ( readonly ) 
+   {
+      execute(MMAP_PRAGMA);
+   }
+}
+
+CCmSqlite::~CCmSqlite()
+{
+   for (auto e : m_stmt)
+   {
+      if (e)
+      {
+         collect_profile(e);
+         delete e;
+      }
+   }
+
+   if ( m_profile ) 
+   {
+      report_profile();
+   }
+
+   sqlite3_close(m_db);
+}
+
+bool CCmSqlite::execute(const char* sql)
+{
+   bool ok = true;
+   char* err = NULL;
+   int rc = sqlite3_exec(m_db, sql, NULL, NULL, &err);
+   if (SQLITE_OK != rc)
+   {
+      if (NULL != err)
+      {
+         CM_LOG_ERROR("%s failed to execute : %s by excute %s!", LOG_HEADER, err, sql);
+         sqlite3_free(err);
+      }
+
+      ok = false;
+   }
+
+   return ok;
+}
+
+CCmSqlite::statement* CCmSqlite::create_statement(const char* s)
+{
+   statement* stmt = nullptr;
+   try
+   {
+      stmt = new statement(m_db, s);
+   }
+   catch(std::exception& e)
+   {
+      CM_LOG_ERROR("%p %s\n", stmt, e.what());
+   }
+
+   if (stmt)
+   {
+      m_stmt.push_back(stmt);
+   }
+
+   return stmt;
+}
+
+/*!
+ *  \brief  the statement of the SQL prepared once for the connection
+ *
+ *  It is reset, and is removed with the connection only.
+ */
+CCmSqlite::statement* CCmSqlite::cached_statement(const char* s)
+{
+   statement* stmt = nullptr;
+   if ( s ) 
+   {
+      auto it = m_cache.find(s);
+      if ( m_cache.end() != it ) 
+      {
+         stmt = it->second;
+         stmt->reset();
+      }
+      else
+      {
+         stmt = create_statement(s);
+         if ( stmt ) 
+         {
+            m_cache[s] = stmt;
+         }
+      }
+   }
+   return stmt;
+}
+
+void CCmSqlite::remove_statement(CCmSqlite::statement* s)
+{
+   auto it = s ? m_cache.find(s->m_sql) : m_cache.end();
+   if ( s && (m_cache.end() == it || s != it->second) ) 
+   {
+      //CM_LOG_INFO("%s remove statement pointer %p", LOG_HEADER, s);
+      auto pos = std::remove(m_stmt.begin(), m_stmt.end(), s);
+      if ( m_stmt.end() != pos )
+      {
+         m_stmt.pop_back();
+         collect_profile(s);
+         delete s;
+      }
+   }
+}
+
+bool CCmSqlite::backup(const char* path)
+{
+   bool ok = false;
+   if(path)
+   {
+      sqlite3* dst_db = nullptr;
+      int rc = sqlite3_open_v2(path, &dst_db, SQLITE_OPEN_CREATE | SQLITE_OPEN_READWRITE, NULL);
+      if (SQLITE_OK == rc)
+      {
+         sqlite3_backup* bak = sqlite3_backup_init(dst_db, "main", m_db, "main");
+         if ( bak ) 
+         {
+            sqlite3_backup_step(bak, -1);
+            sqlite3_backup_finish(bak);
+            ok = true;
+         }
+         else
+         {
+            CM_LOG_WARNING("%s backup destinate path \"%s\" initialize failed!", LOG_HEADER, path);
+         }
+      }
+      else
+      {
+         CM_LOG_WARNING("%s backup destinate path \"%s\" open failed!", LOG_HEADER, path);
+      }
+   }
+   else
+   {
+      CM_LOG_WARNING("%s backup null path!", LOG_HEADER);
+   }
+
+   return ok;
+}
+
+bool CCmSqlite::attach(const char* path, const char* alias)
+{
+   bool ok = false;
+   if ( path && alias ) {
+      std::string sql = std::string("attach database \'") + path + "\' as " + alias + ";";
+      ok = execute(sql.c_str());
+   }
+   return ok;
+}
+
+/*!
+ *  \brief  copy the table of the attached DB into the main DB
+ *
+ *  The table is created by its SQL in the attached DB, so "insert into ...
+ *  select *" copies the records as they are, without decoding the columns.
+ */
+bool CCmSqlite::copy_table(const char* alias, const char* table)
+{
+   bool ok = false;
+   if ( alias && table ) {
+      std::string sql = std::string("select sql from ") + alias + ".sqlite_master where type = 'table' and name = '" + table + "';";
+      std::string create;
+      auto stmt = create_statement(sql.c_str());
+      if ( stmt && stmt->step_row() && stmt->get_text(0) ) {
+         create = stmt->get_text(0);
+      }
+      remove_statement(stmt);
+
+      if ( create.empty() ) {
+         CM_LOG_WARNING("%s no table %s.%s to copy!", LOG_HEADER, alias, table);
+      }
+      else if ( execute(create.c_str()) ) {
+         sql = std::string("insert into ") + table + " select * from " + alias + "." + table + ";";
+         ok = execute(sql.c_str());
+      }
+   }
+   return ok;
+}
+
+bool CCmSqlite::detach(const char* db)
+{
+   bool ok = false;
+   if ( db ) {
+      std::string sql = std::string("detach database ") + db + ";";
+      ok = execute(sql.c_str());
+   }
+   return ok;
+}
+
+/*!
+ *  \brief  switch the statement profiling
+ *
+ *  When it is on, the run time of every statement is traced by
+ *  sqlite3_trace_v2(), and the sqlite3_stmt_status() counters are collected
+ *  per SQL text when the statement is removed. The result is reported when
+ *  the database is closed.
+ */
+void CCmSqlite::set_profile(bool on)
+{
+   m_profile = on;
+   if ( m_profile ) 
+   {
+      sqlite3_trace_v2(m_db, SQLITE_TRACE_PROFILE, &CCmSqlite::on_trace, this);
+   }
+   else
+   {
+      sqlite3_trace_v2(m_db, 0, NULL, NULL);
+   }
+}
+
+int CCmSqlite::on_trace(unsigned type, void* ctx, void* p, void* x)
+{
+   if ( SQLITE_TRACE_PROFILE == type && ctx && p && x ) 
+   {
+      auto self = static_cast<CCmSqlite*>(ctx);
+      auto stmt = static_cast<sqlite3_stmt*>(p);
+      const char* sql = sqlite3_sql(stmt);
+      if ( sql ) 
+      {
+         self->m_prof[sql].nanosec += *static_cast<sqlite3_int64*>(x);
+      }
+   }
+
+   return 0;
+}
+
+void CCmSqlite::collect_profile(statement* s)
+{
+   if ( m_profile && s ) 
+   {
+      auto& prof = m_prof[s->m_sql];
+      prof.prepares++;
+      prof.steps     += s->m_steps;
+      prof.fullscan  += sqlite3_stmt_status(s->m_stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, 0);
+      prof.sorts     += sqlite3_stmt_status(s->m_stmt, SQLITE_STMTSTATUS_SORT, 0);
+      prof.autoindex += sqlite3_stmt_status(s->m_stmt, SQLITE_STMTSTATUS_AUTOINDEX, 0);
+      prof.vm_steps  += sqlite3_stmt_status(s->m_stmt, SQLITE_STMTSTATUS_VM_STEP, 0);
+      prof.params     = sqlite3_bind_parameter_count(s->m_stmt);
+   }
+}
+
+/*!
+ *  \brief  report the collected statement statistics, the slowest first
+ *
+ *  A statement taking bound parameters and still doing full scan steps is
+ *  a lookup without usable index, it is reported as a warning.
+ */
+void CCmSqlite::report_profile()
+{
+   std::vector<std::pair<std::string, profile>> v(m_prof.begin(), m_prof.end());
+   std::sort(v.begin(), v.end(), [](const std::pair<std::string, profile>& a, const std::pair<std::string, profile>& b){
+      return a.second.nanosec > b.second.nanosec;
+   });
+
+   CM_LOG_INFO("%s ======== statement profile (%zu SQL texts) ========", LOG_HEADER, v.size());
+   for (const auto& e : v)
+   {
+      const auto& prof = e.second;
+      CM_LOG_INFO("%s %10.3f ms, prepare %llu, step %llu, full scan %llu, sort %llu, auto index %llu, VM step %llu : %s",
+         LOG_HEADER, prof.nanosec / 1e6,
+         static_cast<unsigned long long>(prof.prepares),
+         static_cast<unsigned long long>(prof.steps),
+         static_cast<unsigned long long>(prof.fullscan),
+         static_cast<unsigned long long>(prof.sorts),
+         static_cast<unsigned long long>(prof.autoindex),
+         static_cast<unsigned long long>(prof.vm_steps),
+         e.first.c_str());
+
+      if ( prof.params > 0 && prof.fullscan > 0 ) 
+      {
+         CM_LOG_WARNING("%s unindexed lookup, %llu full scan steps : %s", LOG_HEADER,
+            static_cast<unsigned long long>(prof.fullscan), e.first.c_str());
+      }
+   }
+}
+//-----------------------------------------------------------------------------
+//  Class CCmSqlite::statement Implement Section
+//-----------------------------------------------------------------------------
+CCmSqlite::statement::statement(sqlite3* db, const char* s) : m_sql(s), m_steps(0)
+{
+   int rc = sqlite3_prepare(db, s, -1, &m_stmt, NULL);
+   if (SQLITE_OK != rc)
+   {
+      std::ostringstream os;
+      os << "statement prepared error! The statement is \"" << s <<"\". " << sqlite3_errmsg(db);
+      throw std::logic_error(os.str());
+   }
+}
+
+CCmSqlite::statement::~statement()
+{
+   sqlite3_finalize(m_stmt);
+}
+
+bool CCmSqlite::statement::step()
+{
+   bool ok = false;
+   m_steps++;
+   int rc = sqlite3_step(m_stmt);
+   if (SQLITE_OK == rc || SQLITE_DONE == rc)
+   {
+      ok = true;
+   }
+
+   return ok;
+}
+
+/// \brief the message of the last error on the connection of the statement, the one of step() after reset()
+const char* CCmSqlite::statement::error() const
+{
+   return sqlite3_errmsg(sqlite3_db_handle(m_stmt));
+}
+
+bool CCmSqlite::statement::step_row()
+{
+   bool row = false;
+   m_steps++;
+   int rc = sqlite3_step(m_stmt);
+   if (SQLITE_ROW == rc)
+   {
+      row = true;
+   }
+
+   return row;
+}
+
+const char* CCmSqlite::statement::get_text(size_t pos)
+{
+   return reinterpret_cast<const char*>(sqlite3_column_text(m_stmt, pos));
+}
+
+/*!
+ *  \brief  get the column text without copy
+ *
+ *  The view is valid until the statement is stepped or reset. The text is
+ *  zero terminated as sqlite3_column_text() does.
+ */
+CCmStrView CCmSqlite::statement::get_text_view(size_t pos)
+{
+   auto p = reinterpret_cast<const char*>(sqlite3_column_text(m_stmt, pos));
+   auto n = sqlite3_column_bytes(m_stmt, pos);
+   return p ? CCmStrView(p, n) : CCmStrView();
+}
+
+int64_t CCmSqlite::statement::get_int64(size_t pos)
+{
+   return sqlite3_column_int64(m_stmt, pos);
+}
+
+/*!
+ *  \brief  get the column bytes without copy
+ *
+ *  The bytes are valid until the statement is stepped or reset.
+ */
+const void* CCmSqlite::statement::get_blob(size_t pos, size_t& size)
+{
+   auto p = sqlite3_column_blob(m_stmt, pos);
+   size = sqlite3_column_bytes(m_stmt, pos);
+   return p;
+}
+
+/*!
+ *  \brief  get the storage class of the column
+ *
+ *  SQLITE_INTEGER, SQLITE_FLOAT, SQLITE_TEXT, SQLITE_BLOB or SQLITE_NULL.
+ *  Call it before any get_xxx() of the column, they may convert the value.
+ */
+int CCmSqlite::statement::get_type(size_t pos)
+{
+   return sqlite3_column_type(m_stmt, pos);
+}
+
+bool CCmSqlite::statement::bind_text(size_t pos, const char* s)
+{
    sqlite3_bind_text(m_stmt, pos, s, -1, NULL);
-   return true;
-}
-
-void CCmSqlite::statement::reset()
-{
-   sqlite3_reset(m_stmt);
-}
+   return true;
+}
+
+/// \brief bind the text without copy, it has to live until the statement is stepped
+bool CCmSqlite::statement::bind_text(size_t pos, const CCmStrView& s)
+{
+   return SQLITE_OK == sqlite3_bind_text(m_stmt, pos, s.data(), s.size(), NULL);
+}
+
+bool CCmSqlite::statement::bind_int64(size_t pos, int64_t v)
+{
+   return SQLITE_OK == sqlite3_bind_int64(m_stmt, pos, v);
+}
+
+void CCmSqlite::statement::reset()
+{
+   sqlite3_reset(m_stmt);
+}
+
+//-----------------------------------------------------------------------------
+//  Class CCmSqlitePool Implement Section
+//-----------------------------------------------------------------------------
+CCmSqlitePool::lease::lease(CCmSqlitePool* pool, CCmSqlite* db) : m_pool(pool), m_db(db)
+{
+}
+
+CCmSqlitePool::lease::lease(lease&& o) : m_pool(o.m_pool), m_db(o.m_db)
+{
+   o.m_db = nullptr;
+}
+
+CCmSqlitePool::lease::~lease()
+{
+   if ( m_db ) 
+   {
+      m_pool->release(m_db);
+   }
+}
+
+/// \brief open the connections, throw as CCmSqlite if any failed
+CCmSqlitePool::CCmSqlitePool(const char* path, size_t size, bool readonly)
+{
+   for (size_t i = 0; i < std::max<size_t>(size, 1); ++i)
+   {
+      m_conn.emplace_back(new CCmSqlite(path, readonly));
+      m_free.push_back(m_conn.back().get());
+   }
+   CM_LOG_INFO("%s %zu connections to \"%s\"%s.", LOG_HEADER, m_conn.size(), path, readonly ? ", read only" : "");
+}
+
+/// \brief lease a connection, wait until one is given back if none is free
+CCmSqlitePool::lease CCmSqlitePool::acquire()
+{
+   std::unique_lock<std::mutex> lock(m_mtx);
+   m_cv.wait(lock, [this](){ return ! m_free.empty(); });
+   auto db = m_free.back();
+   m_free.pop_back();
+   return lease(this, db);
+}
+
+void CCmSqlitePool::release(CCmSqlite* db)
+{
+   {
+      std::lock_guard<std::mutex> lock(m_mtx);
+      m_free.push_back(db);
+   }
+   m_cv.notify_one();
+}
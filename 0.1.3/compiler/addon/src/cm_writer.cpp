@@ -0,0 +1,306 @@
+/*!
+ *    \file  cm_writer.cpp
+ *   \brief  bin file writer implement
+ *
+ *  the records are gathered into the double buffers, and a full buffer is
+ *  handed to the writer thread, which writes it by pwrite.
+ *
+ *  \author  Wang Xiaolong (WXL), wangxl3@mapbar.com
+ *
+ *  \internal
+ *       Created:  10/19/2026
+ *      Revision:  none
+ *      Compiler:  gcc
+ *  Organization:  mapbar co.
+ *     Copyright:  mapbar
+ *
+ *  This source code is released for free distribution under the terms of the
+ *  GNU General Public License as published by the Free Software Foundation.
+ */
+
+//-----------------------------------------------------------------------------
+//  Header Section
+//-----------------------------------------------------------------------------
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/stat.h>
+#if defined(_MSC_VER)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#include "cm_writer.hpp"
+#include "cm_debug.h"
+
+//-----------------------------------------------------------------------------
+//  MACRO Defination
+//-----------------------------------------------------------------------------
+#define LOG_HEADER "[CM_WRITER]"
+
+//-----------------------------------------------------------------------------
+//  Constants Defination
+//-----------------------------------------------------------------------------
+static const size_t IO_ALIGN = 4096;   ///< the buffer, size and offset alignment of O_DIRECT
+
+//-----------------------------------------------------------------------------
+//  Local Utility
+//-----------------------------------------------------------------------------
+/// \brief open the file to write, with O_DIRECT if possible
+static int _open(const char* path, bool& direct)
+{
+   int fd = -1;
+   direct = false;
+#if defined(_MSC_VER)
+   fd = ::_open(path, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#elif defined(__linux__)
+   fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+   direct = fd >= 0;
+   if ( fd < 0 && EINVAL == errno )
+   {
+      // tmpfs and some others refuse O_DIRECT
+      fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+   }
+#else
+   // the other POSIX systems, without O_DIRECT
+   fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+   return fd;
+}
+
+/// \brief write all the bytes at the offset
+static bool _pwrite(int fd, const char* p, size_t n, uint64_t off, size_t& writes)
+{
+   while ( n > 0 )
+   {
+#if defined(_MSC_VER)
+      auto got = ( ::_lseeki64(fd, off, SEEK_SET) < 0 ) ? -1 : ::_write(fd, p, static_cast<unsigned>(n));
+#else
+      auto got = ::pwrite(fd, p, n, static_cast<off_t>(off));
+#endif
+      writes++;
+      if ( got < 0 && EINTR == errno )
+      {
+         continue;
+      }
+      if ( got <= 0 )
+      {
+         return false;
+      }
+      p += got;
+      n -= got;
+      off += got;
+   }
+   return true;
+}
+
+static void _close(int fd)
+{
+#if defined(_MSC_VER)
+   ::_close(fd);
+#else
+   ::close(fd);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+//  Class CCmBinWriter Implement Section
+//-----------------------------------------------------------------------------
+CCmBinWriter::CCmBinWriter(const char* path, bool big_endian, size_t blksiz)
+: m_path(path)
+, m_fd(-1)
+, m_direct(false)
+, m_big(big_endian)
+, m_ok(false)
+, m_blksiz((std::max<size_t>(blksiz, 1) + IO_ALIGN - 1) / IO_ALIGN * IO_ALIGN)
+, m_mem(2 * m_blksiz + IO_ALIGN)
+, m_cur(0)
+, m_len(0)
+, m_off(0)
+, m_pending(false)
+, m_stop(false)
+, m_flush_buf(0)
+, m_flush_len(0)
+, m_flush_off(0)
+, m_flush_ok(true)
+, m_writes(0)
+{
+   auto addr = reinterpret_cast<uintptr_t>(m_mem.data());
+   m_buf[0] = m_mem.data() + (IO_ALIGN - addr % IO_ALIGN) % IO_ALIGN;
+   m_buf[1] = m_buf[0] + m_blksiz;
+
+   m_fd = _open(path, m_direct);
+   m_ok = m_fd >= 0;
+   if ( m_ok )
+   {
+      m_flusher = std::thread(&CCmBinWriter::run, this);
+   }
+   else
+   {
+      CM_LOG_ERROR("%s open \"%s\" failed, %s!", LOG_HEADER, path, std::strerror(errno));
+   }
+}
+
+CCmBinWriter::~CCmBinWriter()
+{
+   close();
+}
+
+void CCmBinWriter::write(const void* data, size_t n)
+{
+   auto p = static_cast<const char*>(data);
+   while ( n > 0 && m_ok )
+   {
+      size_t k = std::min(n, m_blksiz - m_len);
+      std::memcpy(m_buf[m_cur] + m_len, p, k);
+      m_len += k;
+      p += k;
+      n -= k;
+      if ( m_blksiz == m_len )
+      {
+         submit();
+      }
+   }
+}
+
+/*!
+ *  \brief  overwrite the bytes at the offset, which are written before
+ *
+ *  The bytes still in the buffer are changed there, the others on the disk.
+ */
+void CCmBinWriter::patch(uint64_t pos, const void* data, size_t n)
+{
+   finish();
+   auto p = static_cast<const char*>(data);
+   if ( m_ok && pos < m_off )
+   {
+      // on the disk, not aligned for O_DIRECT
+      size_t k = static_cast<size_t>(std::min<uint64_t>(n, m_off - pos));
+      buffered();
+      m_ok = _pwrite(m_fd, p, k, pos, m_writes);
+      p += k;
+      pos += k;
+      n -= k;
+   }
+
+   if ( m_ok && n > 0 )
+   {
+      if ( pos + n <= tell() )
+      {
+         std::memcpy(m_buf[m_cur] + (pos - m_off), p, n);
+      }
+      else
+      {
+         CM_LOG_ERROR("%s patch out of \"%s\" !", LOG_HEADER, m_path.c_str());
+         m_ok = false;
+      }
+   }
+}
+
+/// \brief write the rest bytes and close the file, false if any write failed
+bool CCmBinWriter::close()
+{
+   if ( m_fd >= 0 )
+   {
+      finish();
+      if ( m_ok && m_len > 0 )
+      {
+         buffered();
+         m_ok = _pwrite(m_fd, m_buf[m_cur], m_len, m_off, m_writes);
+         m_off += m_len;
+         m_len = 0;
+      }
+      stop();
+      _close(m_fd);
+      m_fd = -1;
+
+      if ( m_ok )
+      {
+         CM_LOG_INFO("%s \"%s\" %llu bytes, %zu writes%s.", LOG_HEADER, m_path.c_str(),
+            static_cast<unsigned long long>(m_off), m_writes, m_direct ? ", O_DIRECT" : "");
+      }
+      else
+      {
+         CM_LOG_ERROR("%s write \"%s\" failed, %s!", LOG_HEADER, m_path.c_str(), std::strerror(errno));
+      }
+   }
+   return m_ok;
+}
+
+/// \brief hand the full buffer to the flusher, and go on with the other one
+void CCmBinWriter::submit()
+{
+   finish();
+   if ( m_ok )
+   {
+      {
+         std::lock_guard<std::mutex> lock(m_mutex);
+         m_flush_buf = m_cur;
+         m_flush_len = m_len;
+         m_flush_off = m_off;
+         m_pending = true;
+      }
+      m_cond.notify_all();
+      m_off += m_len;
+      m_cur ^= 1;
+      m_len = 0;
+   }
+}
+
+/// \brief wait for the buffer handed to the flusher to be written
+void CCmBinWriter::finish()
+{
+   std::unique_lock<std::mutex> lock(m_mutex);
+   m_cond.wait(lock, [this](){ return ! m_pending; });
+   m_ok = m_ok && m_flush_ok;
+}
+
+/// \brief the flusher, writes the buffers handed to it till stopped
+void CCmBinWriter::run()
+{
+   std::unique_lock<std::mutex> lock(m_mutex);
+   for (;;)
+   {
+      m_cond.wait(lock, [this](){ return m_pending || m_stop; });
+      if ( ! m_pending )
+      {
+         break;
+      }
+      lock.unlock();
+      bool ok = _pwrite(m_fd, m_buf[m_flush_buf], m_flush_len, m_flush_off, m_writes);
+      lock.lock();
+      m_flush_ok = ok;
+      m_pending = false;
+      m_cond.notify_all();
+   }
+}
+
+/// \brief stop the flusher after the buffer handed to it
+void CCmBinWriter::stop()
+{
+   if ( m_flusher.joinable() )
+   {
+      {
+         std::lock_guard<std::mutex> lock(m_mutex);
+         m_stop = true;
+      }
+      m_cond.notify_all();
+      m_flusher.join();
+   }
+}
+
+/// \brief turn O_DIRECT off for the writes not aligned
+void CCmBinWriter::buffered()
+{
+#if defined(__linux__)
+   int flags = m_direct ? fcntl(m_fd, F_GETFL) : 0;
+   if ( flags > 0 && (flags & O_DIRECT) )
+   {
+      if ( 0 != fcntl(m_fd, F_SETFL, flags & ~O_DIRECT) )
+      {
+         CM_LOG_WARNING("%s O_DIRECT of \"%s\" is not turned off!", LOG_HEADER, m_path.c_str());
+      }
+   }
+#endif
+}
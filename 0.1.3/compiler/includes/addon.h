@@ -1,5 +1,16 @@
 #pragma once
 
+/// \brief the options without a letter, given to cm_option() by these values
+enum
+{
+   CM_OPT_MEM_LIMIT = 256,             ///< --mem-limit
+   CM_OPT_BIG_ENDIAN,                  ///< --big-endian
+   CM_OPT_VALIDATE,                    ///< --validate
+   CM_OPT_OVERFLOW,                    ///< --overflow
+};
+
+int cm_option(int opt, const char* arg);
 int cm_import_mid(const char* path);
 int cm_parse_db(const char* path);
 int cm_argv(int, char*[]);
+int cm_compare(const char* golden, const char* path);
@@ -0,0 +1,179 @@
+# usage : cmake -DEXE=cm_test -DCASE=db -DFIXTURE=dir -DGOLDEN=dir -DWORK=dir -P golden.cmake
+#
+# The fixture mids are copied into WORK and compiled by the commands of the
+# CASE, then the bins are compared with the ones of GOLDEN/<set> by
+# "cm_test -c", which prints the differences by the decoded fields. The big
+# endian bins are compared byte by byte, "-c" decodes little endian only.
+#
+# To update the golden bins after an intended change of the format, run the
+# case and copy the bins of WORK into GOLDEN/<set>.
+#
+# The validate case has no golden bins. The mids of FIXTURE/validate hold
+# each issue of --validate, and the counts it logs are checked.
+
+set(BINS Nbeijing.bin CRbeijing.bin Toll_ETAbeijing.bin Toll_Patternbeijing.bin HW_Junction.bin beijing_C_CR_Toll.bin)
+set(TABLES Nbeijing CRbeijing Toll_ETAbeijing Toll_Patternbeijing HW_Junction)
+set(C_MIDS Cbeijing.mid CRbeijing.mid Toll_ETAbeijing.mid Toll_Patternbeijing.mid)
+set(C_DBS Cbeijing.db CRbeijing.db Toll_ETAbeijing.db Toll_Patternbeijing.db)
+
+# the output is left in RUN_OUT of the caller
+function(_run)
+  execute_process(COMMAND ${EXE} ${ARGN} WORKING_DIRECTORY ${WORK}
+    RESULT_VARIABLE rc OUTPUT_VARIABLE out ERROR_VARIABLE out)
+  if(NOT rc EQUAL 0)
+    message(FATAL_ERROR "cm_test ${ARGN} : ${rc}\n${out}")
+  endif()
+  set(RUN_OUT "${out}" PARENT_SCOPE)
+endfunction()
+
+# import the mids into the dbs
+function(_import)
+  foreach(t ${TABLES} Cbeijing)
+    _run(${ARGN} ${t}.mid)
+  endforeach()
+endfunction()
+
+# the bins of the tables, and the one of C-CR-Toll by its db
+function(_parse)
+  foreach(t ${TABLES})
+    _run(${ARGN} ${t}.db)
+  endforeach()
+  _run(${ARGN} ${C_DBS})
+  _run(${ARGN} beijing_C_CR_Toll.db)
+endfunction()
+
+function(_compare set)
+  foreach(b ${ARGN})
+    execute_process(COMMAND ${EXE} -c ${GOLDEN}/${set}/${b} ${WORK}/${b} RESULT_VARIABLE rc)
+    if(NOT rc EQUAL 0)
+      message(SEND_ERROR "${b} differs from ${set}/${b}")
+    endif()
+  endforeach()
+endfunction()
+
+function(_compare_bytes set)
+  foreach(b ${ARGN})
+    execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${GOLDEN}/${set}/${b} ${WORK}/${b} RESULT_VARIABLE rc)
+    if(NOT rc EQUAL 0)
+      message(SEND_ERROR "${b} differs from ${set}/${b}")
+    endif()
+  endforeach()
+endfunction()
+
+# the issues logged by the validator in RUN_OUT, each "<count> <issue>", the
+# count 0 for the issue not logged; the total is the sum of them
+function(_expect_issues)
+  set(total 0)
+  foreach(e ${ARGN})
+    string(REGEX MATCH "^([0-9]+) (.+)$" m "${e}")
+    set(n ${CMAKE_MATCH_1})
+    set(issue ${CMAKE_MATCH_2})
+    math(EXPR total "${total} + ${n}")
+    if(n EQUAL 0)
+      if(RUN_OUT MATCHES "\\[CM_CHECK\\] [0-9]+ ${issue},")
+        message(SEND_ERROR "\"${issue}\" is reported\n${RUN_OUT}")
+      endif()
+    elseif(NOT RUN_OUT MATCHES "\\[CM_CHECK\\] ${n} ${issue},")
+      message(SEND_ERROR "\"${issue}\" is not reported ${n} times\n${RUN_OUT}")
+    endif()
+  endforeach()
+  if(NOT RUN_OUT MATCHES "\\[CM_CHECK\\] [0-9]+ C rows probed, ${total} issues found\\.")
+    message(SEND_ERROR "the issues found are not ${total}\n${RUN_OUT}")
+  endif()
+endfunction()
+
+file(REMOVE_RECURSE ${WORK})
+file(MAKE_DIRECTORY ${WORK})
+if(CASE STREQUAL "validate")
+  file(GLOB mids ${FIXTURE}/validate/*.mid)
+else()
+  file(GLOB mids ${FIXTURE}/*.mid)
+endif()
+file(COPY ${mids} DESTINATION ${WORK})
+
+if(CASE STREQUAL "db")
+  _import()
+  _parse()
+  _compare(db ${BINS})
+elseif(CASE STREQUAL "typed")
+  _import(-t)
+  _parse()
+  _compare(db ${BINS})
+elseif(CASE STREQUAL "crlf")
+  foreach(m ${mids})
+    get_filename_component(n ${m} NAME)
+    file(READ ${m} text)
+    # the last fields unquoted, so the '\r' is not cut by the quotes
+    string(REGEX REPLACE "\"([^\",]+)\"\n" "\\1\r\n" text "${text}")
+    string(REGEX REPLACE "([^\r])\n" "\\1\r\n" text "${text}")
+    file(WRITE ${WORK}/${n} "${text}")
+  endforeach()
+  _import()
+  _parse()
+  _compare(db ${BINS})
+  _run(${C_MIDS})
+  _compare(db beijing_C_CR_Toll.bin)
+elseif(CASE STREQUAL "direct")
+  _run(${C_MIDS})
+  _compare(db beijing_C_CR_Toll.bin)
+elseif(CASE STREQUAL "jobs")
+  _import(-j 3)
+  _parse(-j 3)
+  _compare(db ${BINS})
+  _run(-j 3 ${C_MIDS})
+  _compare(db beijing_C_CR_Toll.bin)
+elseif(CASE STREQUAL "tiles")
+  _import()
+  _parse(-g)
+  _compare(g HW_Junction.bin beijing_C_CR_Toll.bin)
+elseif(CASE STREQUAL "index")
+  _import()
+  _parse(-r -s -i)
+  _compare(rsi beijing_C_CR_Toll.bin)
+  _run(-r -s -i ${C_MIDS})
+  _compare(rsi beijing_C_CR_Toll.bin)
+elseif(CASE STREQUAL "mem_limit")
+  _import(--mem-limit 1K)
+  _parse(--mem-limit 1K -g -j 2)
+  _compare(g HW_Junction.bin beijing_C_CR_Toll.bin)
+elseif(CASE STREQUAL "big_endian")
+  _import()
+  _parse(--big-endian)
+  _compare_bytes(be ${BINS})
+elseif(CASE STREQUAL "overflow")
+  _import()
+  _parse(--overflow)
+  _compare(overflow Toll_ETAbeijing.bin beijing_C_CR_Toll.bin)
+elseif(CASE STREQUAL "validate")
+  # the direct path reads the duplicated CondIDs, the db keeps the first
+  # of them only, by the unique CondId
+  _run(--validate ${C_MIDS})
+  set(dangling "1 CRIDs of C not in CR" "1 CondIDs of C in neither Toll ETA nor Toll pattern")
+  _expect_issues(${dangling}
+    "1 CondIDs of more than one Toll ETA"
+    "1 CondIDs of more than one Toll pattern"
+    "1 C rows of the CRs truncated"
+    "1 C rows of the Toll ETA dropped for the lanes"
+    "0 C rows of the Toll ETA lanes truncated")
+  # the overflow keeps the CRs and the lanes of the fixture
+  _run(--validate --overflow ${C_MIDS})
+  _expect_issues(${dangling}
+    "1 CondIDs of more than one Toll ETA"
+    "1 CondIDs of more than one Toll pattern"
+    "0 C rows of the CRs truncated"
+    "0 C rows of the Toll ETA dropped for the lanes"
+    "0 C rows of the Toll ETA lanes truncated")
+  foreach(m ${C_MIDS})
+    _run(${m})
+  endforeach()
+  _run(${C_DBS})
+  _run(--validate -j 3 beijing_C_CR_Toll.db)
+  _expect_issues(${dangling}
+    "0 CondIDs of more than one Toll ETA"
+    "0 CondIDs of more than one Toll pattern"
+    "1 C rows of the CRs truncated"
+    "1 C rows of the Toll ETA dropped for the lanes"
+    "0 C rows of the Toll ETA lanes truncated")
+else()
+  message(FATAL_ERROR "unknown case \"${CASE}\"")
+endif()